@@ -0,0 +1,56 @@
+{
+  "target_defaults": {
+    "cflags_cc": ["-std=c++17", "-O2"],
+    "cflags_cc!": ["-fno-exceptions", "-std=gnu++17"],
+    "xcode_settings": {
+      "CLANG_CXX_LANGUAGE_STANDARD": "c++17",
+      "GCC_ENABLE_CPP_EXCEPTIONS": "YES"
+    },
+    "msvs_settings": {
+      "VCCLCompilerTool": {
+        "AdditionalOptions": ["/std:c++17"],
+        "ExceptionHandling": 1
+      }
+    }
+  },
+  "targets": [
+    {
+      "target_name": "dna_engine_lib",
+      "type": "static_library",
+      "sources": [
+        "../../dna-cpp/src/aho_corasick.cpp",
+        "../../dna-cpp/src/approximate.cpp",
+        "../../dna-cpp/src/bit_parallel.cpp",
+        "../../dna-cpp/src/csv_reader.cpp",
+        "../../dna-cpp/src/dataset_cache.cpp",
+        "../../dna-cpp/src/dna_engine_api.cpp",
+        "../../dna-cpp/src/fm_index.cpp",
+        "../../dna-cpp/src/json_output.cpp",
+        "../../dna-cpp/src/kmer_filter.cpp",
+        "../../dna-cpp/src/kmp.cpp",
+        "../../dna-cpp/src/mapped_csv.cpp",
+        "../../dna-cpp/src/metrics.cpp",
+        "../../dna-cpp/src/packed_dna.cpp",
+        "../../dna-cpp/src/parallel_search.cpp",
+        "../../dna-cpp/src/rabin_karp.cpp",
+        "../../dna-cpp/src/result_cache.cpp",
+        "../../dna-cpp/src/result_codec.cpp",
+        "../../dna-cpp/src/result_writer.cpp",
+        "../../dna-cpp/src/search_engine.cpp",
+        "../../dna-cpp/src/search_service.cpp",
+        "../../dna-cpp/src/sequence_stream.cpp",
+        "../../dna-cpp/src/simd_search.cpp",
+        "../../dna-cpp/src/stream_pipeline.cpp"
+      ]
+    },
+    {
+      "target_name": "dna_engine",
+      "sources": ["dna_addon.cpp"],
+      "include_dirs": ["../../dna-cpp/src"],
+      "dependencies": [
+        "dna_engine_lib",
+        "<!(node -p \"require('node-addon-api').targets\"):node_addon_api_except"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,238 @@
+// Addon N-API del motor de búsqueda: el backend busca en el mismo proceso, sin lanzar
+// dna_engine ni leer archivos JSON. La búsqueda se ejecuta en el pool de hilos de libuv
+// y las posiciones se devuelven como BigInt64Array sin copiarlas.
+
+#include <napi.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "search_service.hpp"
+
+// CSV ya cargados, compartidos entre búsquedas igual que en el modo servidor.
+const size_t ADDON_CACHE_CAPACITY = 8;
+
+static DatasetCache& sharedCache() {
+    static DatasetCache cache(ADDON_CACHE_CAPACITY);
+    return cache;
+}
+
+// Entrega el vector a JavaScript como arreglo tipado (Int32Array o BigInt64Array); el
+// vector se libera cuando el recolector de basura descarta el arreglo.
+template <typename T>
+static Napi::TypedArrayOf<T> toTypedArray(Napi::Env env, std::vector<T>&& values) {
+    if (values.empty()) {
+        return Napi::TypedArrayOf<T>::New(env, 0);
+    }
+    auto* owned = new std::vector<T>(std::move(values));
+    Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(
+        env, owned->data(), owned->size() * sizeof(T),
+        [](Napi::Env, void*, std::vector<T>* data) { delete data; }, owned);
+    return Napi::TypedArrayOf<T>::New(env, owned->size(), buffer, 0);
+}
+
+// Hebra de cada posición ('+' o '-') como arreglo de cadenas.
+static Napi::Array strandsToArray(Napi::Env env, const std::vector<char>& strands) {
+    Napi::Array array = Napi::Array::New(env, strands.size());
+    for (size_t i = 0; i < strands.size(); ++i) {
+        array.Set(static_cast<uint32_t>(i), Napi::String::New(env, &strands[i], 1));
+    }
+    return array;
+}
+
+// Las mismas métricas, con los mismos nombres, que el JSON, el NDJSON y la API en C.
+static Napi::Object metricsToObject(Napi::Env env, const SearchMetrics& metrics) {
+    Napi::Object object = Napi::Object::New(env);
+    for (const auto& field : metricFields(metrics)) {
+        object.Set(field.first, static_cast<double>(field.second));
+    }
+    return object;
+}
+
+// Búsqueda en segundo plano: Execute corre en un hilo del pool de libuv y no puede tocar
+// objetos de JavaScript; OnOK y OnError vuelven al hilo principal para resolver la promesa.
+class SearchWorker : public Napi::AsyncWorker {
+public:
+    SearchWorker(Napi::Env env, SearchRequest request, Napi::Reference<Napi::Buffer<char>> csv_buffer)
+        : Napi::AsyncWorker(env), request(std::move(request)), csv_buffer(std::move(csv_buffer)),
+          deferred(Napi::Promise::Deferred::New(env)) {}
+
+    Napi::Promise promise() const { return deferred.Promise(); }
+
+    void Execute() override {
+        outcome = runSearch(request, request.csv_data.empty() ? &sharedCache() : nullptr);
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Object response = Napi::Object::New(env);
+        response.Set("success", outcome.success);
+        response.Set("message", outcome.message);
+        response.Set("algorithm", request.algorithm);
+        response.Set("processing_time_ms", static_cast<double>(outcome.duration_ms));
+
+        Napi::Array suspects = Napi::Array::New(env, outcome.results.size());
+        for (size_t s = 0; s < outcome.results.size(); ++s) {
+            ResultEntry& entry = outcome.results[s];
+            Napi::Object suspect = Napi::Object::New(env);
+            suspect.Set("name", entry.name);
+            suspect.Set("matches_count", static_cast<double>(entry.matches));
+            if (!entry.pattern_hits.empty()) {
+                Napi::Array patterns = Napi::Array::New(env, entry.pattern_hits.size());
+                for (size_t k = 0; k < entry.pattern_hits.size(); ++k) {
+                    PatternHits& hits = entry.pattern_hits[k];
+                    Napi::Object pattern = Napi::Object::New(env);
+                    pattern.Set("marker", hits.marker);
+                    pattern.Set("pattern", hits.pattern);
+                    pattern.Set("matches_count", static_cast<double>(hits.matches));
+                    if (hits.best_distance >= 0) {
+                        pattern.Set("best_distance", hits.best_distance);
+                        pattern.Set("similarity", hits.similarity);
+                        pattern.Set("distances", toTypedArray(env, std::move(hits.distances)));
+                    }
+                    // Las consultas que solo cuentan no tienen posiciones.
+                    if (!hits.positions.empty()) {
+                        pattern.Set("positions", toTypedArray(env, std::move(hits.positions)));
+                    }
+                    if (!hits.strands.empty()) {
+                        pattern.Set("strands", strandsToArray(env, hits.strands));
+                    }
+                    patterns.Set(k, pattern);
+                }
+                suspect.Set("patterns", patterns);
+            } else {
+                if (entry.best_distance >= 0) {
+                    suspect.Set("best_distance", entry.best_distance);
+                    suspect.Set("similarity", entry.similarity);
+                    suspect.Set("distances", toTypedArray(env, std::move(entry.distances)));
+                }
+                if (!entry.positions.empty()) {
+                    suspect.Set("positions", toTypedArray(env, std::move(entry.positions)));
+                }
+                if (!entry.strands.empty()) {
+                    suspect.Set("strands", strandsToArray(env, entry.strands));
+                }
+            }
+            suspects.Set(s, suspect);
+        }
+        response.Set("suspects", suspects);
+        if (outcome.success) {
+            response.Set("metrics", metricsToObject(env, outcome.metrics));
+        }
+        csv_buffer.Reset();
+        deferred.Resolve(response);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        csv_buffer.Reset();
+        deferred.Reject(error.Value());
+    }
+
+private:
+    SearchRequest request;
+    SearchOutcome outcome;
+    // Mantiene vivo el Buffer con el CSV mientras la búsqueda lo lee desde otro hilo.
+    Napi::Reference<Napi::Buffer<char>> csv_buffer;
+    Napi::Promise::Deferred deferred;
+};
+
+static std::string stringOption(const Napi::Object& options, const char* key) {
+    Napi::Value value = options.Get(key);
+    return value.IsString() ? value.As<Napi::String>().Utf8Value() : std::string();
+}
+
+// search({ csvPath | csvBuffer, pattern | patterns, algorithm, threads, maxErrors, bothStrands,
+//          query, kmerFilter, stream, chunkSize, pipelineDepth, resultCache, resultCacheLimit }) -> Promise
+// 'patterns' acepta cadenas u objetos { marker, pattern } (modo panel). 'query' acepta
+// "exists", "count", "first=N" o "top=K".
+static Napi::Value Search(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        throw Napi::TypeError::New(env, "Se esperaba un objeto con las opciones de búsqueda");
+    }
+    Napi::Object options = info[0].As<Napi::Object>();
+
+    SearchRequest request;
+    request.algorithm = stringOption(options, "algorithm");
+    if (request.algorithm.empty()) {
+        throw Napi::TypeError::New(env, "algorithm es requerido");
+    }
+
+    Napi::Reference<Napi::Buffer<char>> csv_buffer;
+    Napi::Value buffer_value = options.Get("csvBuffer");
+    if (buffer_value.IsBuffer()) {
+        Napi::Buffer<char> buffer = buffer_value.As<Napi::Buffer<char>>();
+        request.csv_data = std::string_view(buffer.Data(), buffer.Length());
+        csv_buffer = Napi::Persistent(buffer);
+    } else {
+        request.csv_path = stringOption(options, "csvPath");
+        if (request.csv_path.empty()) {
+            throw Napi::TypeError::New(env, "Se requiere csvPath o csvBuffer");
+        }
+    }
+
+    Napi::Value patterns = options.Get("patterns");
+    if (patterns.IsArray()) {
+        Napi::Array list = patterns.As<Napi::Array>();
+        for (uint32_t i = 0; i < list.Length(); ++i) {
+            Napi::Value item = list.Get(i);
+            if (item.IsString()) {
+                std::string pattern = item.As<Napi::String>().Utf8Value();
+                request.panel.push_back({pattern, pattern});
+            } else if (item.IsObject()) {
+                std::string pattern = stringOption(item.As<Napi::Object>(), "pattern");
+                std::string marker = stringOption(item.As<Napi::Object>(), "marker");
+                request.panel.push_back({marker.empty() ? pattern : marker, pattern});
+            }
+        }
+    } else {
+        request.pattern = stringOption(options, "pattern");
+    }
+
+    Napi::Value threads = options.Get("threads");
+    if (threads.IsNumber()) {
+        request.options.threads = threads.As<Napi::Number>().Uint32Value();
+    }
+    Napi::Value max_errors = options.Get("maxErrors");
+    if (max_errors.IsNumber()) {
+        request.options.max_errors = max_errors.As<Napi::Number>().Int32Value();
+    }
+    request.options.both_strands = options.Get("bothStrands").ToBoolean().Value();
+    request.options.kmer_filter = options.Get("kmerFilter").ToBoolean().Value();
+    request.options.stream = options.Get("stream").ToBoolean().Value();
+    Napi::Value chunk_size = options.Get("chunkSize");
+    if (chunk_size.IsNumber() && chunk_size.As<Napi::Number>().Int64Value() > 0) {
+        request.options.chunk_size = chunk_size.As<Napi::Number>().Int64Value();
+    }
+    Napi::Value pipeline_depth = options.Get("pipelineDepth");
+    if (!pipeline_depth.IsUndefined()) {
+        // Igual que --pipeline-depth: 0, un negativo o un decimal no son profundidades válidas
+        // (Uint32Value convertiría -1 en 4294967295).
+        const double depth = pipeline_depth.IsNumber() ? pipeline_depth.As<Napi::Number>().DoubleValue() : 0;
+        if (!(depth >= 1 && depth <= 999999999) || depth != std::floor(depth)) {
+            throw Napi::TypeError::New(env, "pipelineDepth debe ser un entero positivo");
+        }
+        request.options.pipeline_depth = static_cast<size_t>(depth);
+    }
+    const std::string query = stringOption(options, "query");
+    if (!query.empty() && !parseQuery(query, request.options.query)) {
+        throw Napi::TypeError::New(env, "query debe ser all, exists, count, first=N o top=K");
+    }
+    request.options.result_cache_dir = stringOption(options, "resultCache");
+    Napi::Value result_cache_limit = options.Get("resultCacheLimit");
+    if (result_cache_limit.IsNumber() && result_cache_limit.As<Napi::Number>().Int64Value() > 0) {
+        request.options.result_cache_limit = result_cache_limit.As<Napi::Number>().Int64Value();
+    }
+
+    SearchWorker* worker = new SearchWorker(env, std::move(request), std::move(csv_buffer));
+    Napi::Promise promise = worker->promise();
+    worker->Queue(); // el worker se libera solo al terminar
+    return promise;
+}
+
+static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("search", Napi::Function::New(env, Search, "search"));
+    return exports;
+}
+
+NODE_API_MODULE(dna_engine, Init)
@@ -4,8 +4,17 @@ import { executeCppMatcher } from '../utils/cpp.executor.js';
 import fs from 'fs';
 import csvParser from 'csv-parser';
 
+// Índice FM y prefiltro de k-mers que el motor guarda junto al CSV.
+const borrarArchivosAuxiliares = (rutaCsv) => {
+    for (const extension of ['.fmi', '.kmf']) {
+        if (fs.existsSync(`${rutaCsv}${extension}`)) {
+            fs.unlinkSync(`${rutaCsv}${extension}`);
+        }
+    }
+};
+
 export const nuevaBusqueda = async (req, res) => {
-    const { patron, algoritmo } = req.body;
+    const { patron, algoritmo, maxErrores, ambasHebras, consulta } = req.body;
     const archivo = req.file;
 
     try {
@@ -35,11 +44,14 @@ export const nuevaBusqueda = async (req, res) => {
             });
         }
 
-        // Mapear nombres de algoritmo del frontend a los de C++ (KMP, RK, AC)
+        // Mapear nombres de algoritmo del frontend a los de C++ (KMP, RK, AC, ED, HD, FM)
         const mapaAlgoritmos = {
             'KMP': 'KMP',
             'Rabin-Karp': 'RK',
             'Aho-Corasick': 'AC',
+            'Myers': 'ED',
+            'Hamming': 'HD',
+            'FM-Index': 'FM',
         };
 
         if (!Object.keys(mapaAlgoritmos).includes(algoritmo)) {
@@ -52,6 +64,30 @@ export const nuevaBusqueda = async (req, res) => {
 
         const algoritmoCpp = mapaAlgoritmos[algoritmo];
 
+        // Buscar también el complemento reverso (llega como texto en el formulario multipart)
+        const buscarAmbasHebras = ambasHebras === true || ambasHebras === 'true' || ambasHebras === '1';
+
+        // Consulta opcional del motor: solo si aparece, cuántas veces, las primeras N posiciones
+        // o los K sospechosos con más coincidencias
+        if (consulta !== undefined && consulta !== '' && !/^(all|exists|count|first=[1-9]\d*|top=[1-9]\d*)$/.test(consulta)) {
+            fs.unlinkSync(archivo.path);
+            return res.status(400).json({
+                success: false,
+                message: 'consulta debe ser all, exists, count, first=N o top=K',
+            });
+        }
+
+        // Búsqueda aproximada (ED, HD): número máximo de errores permitidos
+        const esAproximada = algoritmoCpp === 'ED' || algoritmoCpp === 'HD';
+        const errores = esAproximada ? Number(maxErrores ?? 1) : 0;
+        if (esAproximada && (!Number.isInteger(errores) || errores < 0 || errores >= patron.length)) {
+            fs.unlinkSync(archivo.path);
+            return res.status(400).json({
+                success: false,
+                message: 'maxErrores debe ser un entero entre 0 y la longitud del patrón menos uno',
+            });
+        }
+
         // 2. Registrar archivo en BD
         const [archivoResult] = await db.query(
             'INSERT INTO ArchivoADN (nombre_archivo, ruta, id_usuario) VALUES (?, ?, ?)',
@@ -81,6 +117,11 @@ export const nuevaBusqueda = async (req, res) => {
             archivo.path,
             patron.toUpperCase(),
             algoritmoCpp,
+            {
+                ...(esAproximada ? { maxErrores: errores } : {}),
+                ...(buscarAmbasHebras ? { ambasHebras: true } : {}),
+                ...(consulta ? { consulta } : {}),
+            },
         );
 
         if (!resultadosCpp || typeof resultadosCpp !== 'object') {
@@ -88,6 +129,7 @@ export const nuevaBusqueda = async (req, res) => {
         }
 
         if (resultadosCpp.success === false) {
+            borrarArchivosAuxiliares(archivo.path);
             return res.status(500).json({
                 success: false,
                 message: resultadosCpp.message || 'Error en motor C++',
@@ -104,10 +146,11 @@ export const nuevaBusqueda = async (req, res) => {
         const idBusqueda = busquedaResult.insertId;
 
         // 6. Guardar resultados por sospechoso
+        // En la búsqueda aproximada el motor informa la mejor distancia y la similitud (%)
         for (const s of sospechosos) {
             await db.query(
                 'INSERT INTO Resultado (id_busqueda, nombre_sospechoso, coincidencia_exacta, similitud) VALUES (?, ?, ?, ?)',
-                [idBusqueda, s.name, true, null],
+                [idBusqueda, s.name, esExacta(s), s.similarity ?? null],
             );
         }
 
@@ -123,9 +166,11 @@ export const nuevaBusqueda = async (req, res) => {
                 coincidencias: sospechosos.length,
                 resultados: sospechosos.map((s) => ({
                     nombre: s.name,
-                    exacta: true,
+                    exacta: esExacta(s),
+                    similitud: s.similarity ?? null,
                     num_coincidencias: s.matches_count,
                     posiciones: s.positions,
+                    ...(s.strands ? { hebras: s.strands } : {}),
                 })),
                 tiempoMs: resultadosCpp.processing_time_ms,
             },
@@ -136,6 +181,9 @@ export const nuevaBusqueda = async (req, res) => {
         if (archivo && fs.existsSync(archivo.path)) {
             fs.unlinkSync(archivo.path);
         }
+        if (archivo) {
+            borrarArchivosAuxiliares(archivo.path);
+        }
 
         res.status(500).json({
             success: false,
@@ -145,6 +193,10 @@ export const nuevaBusqueda = async (req, res) => {
     }
 };
 
+// Un sospechoso es coincidencia exacta si la búsqueda fue exacta o su mejor distancia es 0
+const esExacta = (sospechoso) =>
+    sospechoso.best_distance === undefined || sospechoso.best_distance === 0;
+
 const validarYProcesarCSV = (filePath, idArchivo) => {
     return new Promise((resolve, reject) => {
         const muestras = [];
@@ -1,11 +1,214 @@
 import { spawn } from 'child_process';
+import { createRequire } from 'module';
 import fs from 'fs';
+import net from 'net';
 import path from 'path';
 import dotenv from 'dotenv';
 
 dotenv.config();
 
-export const executeCppMatcher = (csvPath, patron, algoritmo) => {
+// Timeout de seguridad (5 minutos). En el ejecutable cuenta desde el último avance informado
+// por el motor, no desde el inicio de la búsqueda.
+const CPP_TIMEOUT_MS = 300000;
+
+// Addon nativo (native/, se compila con `npm run build:native`). Si no está compilado o
+// CPP_ENGINE_ADDON=0, se usa el servidor o el ejecutable.
+const cargarAddon = () => {
+    if (process.env.CPP_ENGINE_ADDON === '0') return null;
+    try {
+        const require = createRequire(import.meta.url);
+        return require('../../native/build/Release/dna_engine.node');
+    } catch {
+        return null;
+    }
+};
+const addon = cargarAddon();
+
+// Caché de resultados del motor en CPP_RESULTS_DIR/cache, compartida por el addon, el servidor y
+// el ejecutable. CPP_RESULT_CACHE=0 la desactiva; CPP_RESULT_CACHE_MB fija su tamaño máximo.
+const cacheResultados = () => {
+    if (process.env.CPP_RESULT_CACHE === '0' || !process.env.CPP_RESULTS_DIR) return null;
+    const mb = Number(process.env.CPP_RESULT_CACHE_MB);
+    return {
+        carpeta: path.resolve(process.env.CPP_RESULTS_DIR, 'cache'),
+        limite: mb > 0 ? Math.round(mb * 1048576) : undefined,
+    };
+};
+
+// Orden de preferencia: modo coordinador si CPP_WORKERS > 1, addon en el mismo proceso, motor en
+// modo servidor si CPP_ENGINE_SOCKET está definido (dna_engine --server <socket>), o un proceso
+// por búsqueda.
+// csv puede ser una ruta o un Buffer con el contenido del CSV (este último solo con el addon).
+// opciones.maxErrores: errores permitidos en la búsqueda aproximada (algoritmos ED y HD).
+// opciones.ambasHebras: buscar también el complemento reverso del patrón (hebra '-').
+// opciones.consulta: 'exists', 'count', 'first=N' o 'top=K' (por defecto, todas las posiciones).
+// Con 'count' y 'top' los sospechosos no traen posiciones, solo matches_count.
+// opciones.alAvanzar: en modo coordinador, recibe { fragmentos, totalFragmentos, bytes, totalBytes }
+// cada vez que termina un fragmento.
+export const executeCppMatcher = (csv, patron, algoritmo, opciones = {}) => {
+    if (!Buffer.isBuffer(csv) && trabajadoresCoordinador(algoritmo)) {
+        return executeCppProcess(csv, patron, algoritmo, opciones);
+    }
+    if (addon) {
+        return executeCppAddon(csv, patron, algoritmo, opciones);
+    }
+    if (Buffer.isBuffer(csv)) {
+        return Promise.reject(new Error('Buscar en un CSV en memoria requiere el addon nativo'));
+    }
+    if (process.env.CPP_ENGINE_SOCKET) {
+        return executeCppServer(process.env.CPP_ENGINE_SOCKET, csv, patron, algoritmo, opciones);
+    }
+    return executeCppProcess(csv, patron, algoritmo, opciones);
+};
+
+// Búsqueda en el mismo proceso: el addon trabaja en el pool de hilos de libuv y devuelve las
+// posiciones como BigInt64Array. Se convierten a arreglos de números para conservar la forma del
+// JSON del motor.
+export const executeCppAddon = async (csv, patron, algoritmo, opciones = {}) => {
+    const resultado = await addon.search({
+        ...(Buffer.isBuffer(csv) ? { csvBuffer: csv } : { csvPath: path.resolve(csv) }),
+        pattern: patron,
+        algorithm: algoritmo,
+        ...(opciones.maxErrores !== undefined ? { maxErrors: opciones.maxErrores } : {}),
+        ...(opciones.ambasHebras ? { bothStrands: true } : {}),
+        ...(opciones.consulta ? { query: opciones.consulta } : {}),
+        ...(usarPrefiltro() ? { kmerFilter: true } : {}),
+        ...(!Buffer.isBuffer(csv) && leerPorFragmentos(csv, algoritmo) ? { stream: true } : {}),
+        ...opcionesCacheAddon(),
+    });
+    const aArreglos = (item) => ({
+        ...item,
+        ...(item.positions ? { positions: Array.from(item.positions, Number) } : {}),
+        ...(item.distances ? { distances: Array.from(item.distances) } : {}),
+    });
+    return {
+        ...resultado,
+        suspects: resultado.suspects.map((s) => ({
+            ...aArreglos(s),
+            ...(s.patterns ? { patterns: s.patterns.map(aArreglos) } : {}),
+        })),
+    };
+};
+
+// Prefiltro de k-mers del motor: se guarda junto al CSV (archivo.csv.kmf) y evita recorrer los
+// sospechosos en los que el patrón no puede aparecer. Solo conviene si se consulta el mismo
+// archivo varias veces: construirlo cuesta una pasada más sobre el CSV. Cada búsqueda del
+// formulario sube un archivo nuevo, así que se activa solo con CPP_KMER_FILTER=1.
+const usarPrefiltro = () => process.env.CPP_KMER_FILTER === '1';
+
+// Modo coordinador del motor: con CPP_WORKERS > 1, el ejecutable divide el CSV en fragmentos,
+// los busca en ese número de procesos y une los resultados. No se usa con FM, que consulta el
+// índice del CSV completo.
+const trabajadoresCoordinador = (algoritmo) => {
+    const trabajadores = Number(process.env.CPP_WORKERS);
+    return Number.isInteger(trabajadores) && trabajadores > 1 && algoritmo !== 'FM' ? trabajadores : 0;
+};
+
+// Línea de avance del modo coordinador: "PROGRESS: 3/8 fragmentos (1024/4096 bytes)".
+const leerAvance = (linea) => {
+    const partes = /^PROGRESS: (\d+)\/(\d+) fragmentos \((\d+)\/(\d+) bytes\)/.exec(linea);
+    return partes && {
+        fragmentos: Number(partes[1]),
+        totalFragmentos: Number(partes[2]),
+        bytes: Number(partes[3]),
+        totalBytes: Number(partes[4]),
+    };
+};
+
+// Los archivos de más de CPP_STREAM_MB megabytes se leen por fragmentos (lectura, búsqueda y
+// escritura en paralelo, con memoria acotada) en lugar de cargarse completos. No se usa con FM,
+// que consulta el índice del CSV completo.
+const leerPorFragmentos = (csvPath, algoritmo) => {
+    const mb = Number(process.env.CPP_STREAM_MB);
+    if (!(mb > 0) || algoritmo === 'FM') return false;
+    try {
+        return fs.statSync(csvPath).size > mb * 1048576;
+    } catch {
+        return false;
+    }
+};
+
+const opcionesCacheAddon = () => {
+    const cache = cacheResultados();
+    if (!cache) return {};
+    return { resultCache: cache.carpeta, ...(cache.limite ? { resultCacheLimit: cache.limite } : {}) };
+};
+
+// Envía la búsqueda al motor persistente por el socket local.
+// Mensajes con prefijo de longitud (4 bytes big-endian) en ambos sentidos.
+export const executeCppServer = (socketPath, csvPath, patron, algoritmo, opciones = {}) => {
+    return new Promise((resolve, reject) => {
+        const lineas = [`csv=${path.resolve(csvPath)}`, `algorithm=${algoritmo}`, `pattern=${patron}`];
+        if (opciones.maxErrores !== undefined) {
+            lineas.push(`max_errors=${opciones.maxErrores}`);
+        }
+        if (opciones.ambasHebras) {
+            lineas.push('both_strands=1');
+        }
+        if (opciones.consulta) {
+            lineas.push(`query=${opciones.consulta}`);
+        }
+        if (usarPrefiltro()) {
+            lineas.push('kmer_filter=1');
+        }
+        if (leerPorFragmentos(csvPath, algoritmo)) {
+            lineas.push('stream=1');
+        }
+        const cache = cacheResultados();
+        if (cache) {
+            lineas.push(`result_cache=${cache.carpeta}`);
+            if (cache.limite) lineas.push(`result_cache_limit=${cache.limite}`);
+        }
+        const peticion = Buffer.from(lineas.join('\n'), 'utf8');
+        const cabecera = Buffer.alloc(4);
+        cabecera.writeUInt32BE(peticion.length, 0);
+
+        const socket = net.createConnection(socketPath);
+        let recibido = Buffer.alloc(0);
+        let terminado = false;
+
+        const finalizar = (error, json) => {
+            if (terminado) return;
+            terminado = true;
+            socket.destroy();
+            if (error) reject(error);
+            else resolve(json);
+        };
+
+        socket.setTimeout(CPP_TIMEOUT_MS, () => {
+            finalizar(new Error('Timeout: El motor C++ tardó demasiado'));
+        });
+
+        socket.on('connect', () => {
+            socket.write(Buffer.concat([cabecera, peticion]));
+        });
+
+        socket.on('data', (chunk) => {
+            recibido = Buffer.concat([recibido, chunk]);
+            if (recibido.length < 4) return;
+
+            const longitud = recibido.readUInt32BE(0);
+            if (recibido.length < 4 + longitud) return;
+
+            const data = recibido.subarray(4, 4 + longitud).toString('utf8');
+            try {
+                finalizar(null, JSON.parse(data));
+            } catch (error) {
+                finalizar(new Error(`Error al parsear respuesta del motor: ${error.message}\nContenido: ${data}`));
+            }
+        });
+
+        socket.on('error', (error) => {
+            finalizar(new Error(`Error de conexión con el motor C++: ${error.message}`));
+        });
+
+        socket.on('close', () => {
+            finalizar(new Error('El motor C++ cerró la conexión sin responder'));
+        });
+    });
+};
+
+export const executeCppProcess = (csvPath, patron, algoritmo, opciones = {}) => {
     return new Promise((resolve, reject) => {
         const executable = process.env.CPP_EXECUTABLE_PATH;
         if (!executable) {
@@ -20,15 +223,68 @@ export const executeCppMatcher = (csvPath, patron, algoritmo) => {
             fs.mkdirSync(resultsDir, { recursive: true });
         }
 
-        const outputJsonPath = path.join(resultsDir, 'salida.json');
+        // Un archivo por búsqueda: las peticiones concurrentes no se pisan entre sí
+        const outputJsonPath = path.join(
+            resultsDir,
+            `salida-${process.pid}-${Date.now()}-${Math.round(Math.random() * 1e9)}.json`,
+        );
+
+        const args = [csvPath, patron, algoritmo, outputJsonPath];
+        const trabajadores = trabajadoresCoordinador(algoritmo);
+        if (trabajadores) {
+            args.push('--workers', String(trabajadores));
+        }
+        if (opciones.maxErrores !== undefined) {
+            args.push('--max-errors', String(opciones.maxErrores));
+        }
+        if (opciones.ambasHebras) {
+            args.push('--both-strands');
+        }
+        if (opciones.consulta) {
+            args.push('--query', opciones.consulta);
+        }
+        // Los fragmentos del modo coordinador no usan el prefiltro ni la caché de resultados.
+        if (usarPrefiltro() && !trabajadores) {
+            args.push('--kmer-filter');
+        }
+        if (!trabajadores && leerPorFragmentos(csvPath, algoritmo)) {
+            args.push('--stream');
+        }
+        const cache = trabajadores ? null : cacheResultados();
+        if (cache) {
+            args.push('--result-cache', cache.carpeta);
+            if (cache.limite) args.push('--result-cache-limit', String(cache.limite));
+        }
 
-        console.log('Ejecutando:', executable, [csvPath, patron, algoritmo, outputJsonPath]);
+        console.log('Ejecutando:', executable, args);
 
-        const cppProcess = spawn(executable, [csvPath, patron, algoritmo, outputJsonPath], {
+        const cppProcess = spawn(executable, args, {
             windowsHide: true,
         });
 
         let stderrData = '';
+        let stdoutPendiente = '';
+        let timeout;
+
+        // Cualquier salida del motor (p. ej. una línea PROGRESS: por fragmento terminado)
+        // reinicia el timeout: una búsqueda larga que avanza no se interrumpe.
+        const reiniciarTimeout = () => {
+            clearTimeout(timeout);
+            timeout = setTimeout(() => {
+                cppProcess.kill();
+                reject(new Error('Timeout: El proceso C++ tardó demasiado sin avanzar'));
+            }, CPP_TIMEOUT_MS);
+        };
+
+        cppProcess.stdout.on('data', (data) => {
+            reiniciarTimeout();
+            const lineas = (stdoutPendiente + data.toString()).split('\n');
+            stdoutPendiente = lineas.pop();
+            for (const linea of lineas) {
+                const avance = leerAvance(linea);
+                if (avance && opciones.alAvanzar) opciones.alAvanzar(avance);
+            }
+        });
 
         cppProcess.stderr.on('data', (data) => {
             stderrData += data.toString();
@@ -36,6 +292,7 @@ export const executeCppMatcher = (csvPath, patron, algoritmo) => {
         });
 
         cppProcess.on('close', (code) => {
+            clearTimeout(timeout);
             if (code !== 0) {
                 return reject(
                     new Error(`Proceso C++ terminó con código ${code}: ${stderrData || 'sin mensaje'}`)
@@ -44,6 +301,7 @@ export const executeCppMatcher = (csvPath, patron, algoritmo) => {
 
             // Leer el JSON generado por el ejecutable
             fs.readFile(outputJsonPath, 'utf8', (err, data) => {
+                fs.unlink(outputJsonPath, () => {});
                 if (err) {
                     return reject(
                         new Error(`No se pudo leer el archivo de salida JSON: ${err.message}`)
@@ -64,13 +322,10 @@ export const executeCppMatcher = (csvPath, patron, algoritmo) => {
         });
 
         cppProcess.on('error', (error) => {
+            clearTimeout(timeout);
             reject(new Error(`Error al ejecutar C++: ${error.message}`));
         });
 
-        // Timeout de seguridad (5 minutos)
-        setTimeout(() => {
-            cppProcess.kill();
-            reject(new Error('Timeout: El proceso C++ tardó demasiado'));
-        }, 300000);
+        reiniciarTimeout();
     });
 };
@@ -0,0 +1,51 @@
+#!/bin/sh
+# Comprueba que el modo coordinador termina la búsqueda con un servidor caído: un servidor
+# vivo y un socket sin servidor, con reintentos. Cada reintento debe ir al otro servidor, así
+# que el resultado tiene que ser el mismo que el de una búsqueda sin coordinador.
+#
+# Uso: bench/check_worker_failover.sh [ruta_dna_engine] [ruta_csv]
+
+ENGINE=${1:-./dna_engine.exe}
+CSV=${2:-data/archivo.csv}
+PATTERN=ACGT
+WORK=$(mktemp -d)
+SERVER=
+
+cleanup() {
+    [ -n "$SERVER" ] && kill "$SERVER" 2>/dev/null
+    rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+"$ENGINE" --server "$WORK/live.sock" > "$WORK/server.log" 2>&1 &
+SERVER=$!
+for _ in 1 2 3 4 5 6 7 8 9 10; do
+    [ -S "$WORK/live.sock" ] && break
+    sleep 0.2
+done
+if [ ! -S "$WORK/live.sock" ]; then
+    echo "ERROR: El servidor no abrió $WORK/live.sock" >&2
+    exit 1
+fi
+
+"$ENGINE" "$CSV" "$PATTERN" KMP "$WORK/single.ndjson" --format ndjson > /dev/null || exit 1
+if ! "$ENGINE" "$CSV" "$PATTERN" KMP "$WORK/sharded.ndjson" --format ndjson \
+        --worker-socket "$WORK/live.sock" --worker-socket "$WORK/dead.sock" --shards 5 --retries 3 \
+        > /dev/null 2> "$WORK/coordinator.log"; then
+    echo "ERROR: El coordinador falló con un servidor caído:" >&2
+    cat "$WORK/coordinator.log" >&2
+    exit 1
+fi
+
+# La última línea lleva el tiempo y las métricas; los sospechosos deben ser idénticos.
+head -n -1 "$WORK/single.ndjson" > "$WORK/single.suspects"
+head -n -1 "$WORK/sharded.ndjson" > "$WORK/sharded.suspects"
+if ! cmp -s "$WORK/single.suspects" "$WORK/sharded.suspects"; then
+    echo "ERROR: El resultado del coordinador difiere de la búsqueda sin coordinador." >&2
+    exit 1
+fi
+if ! tail -n 1 "$WORK/sharded.ndjson" | grep -q '"success":true'; then
+    echo "ERROR: El coordinador no informó éxito." >&2
+    exit 1
+fi
+echo "OK: la búsqueda terminó con un servidor caído ($(grep -c ADVERTENCIA "$WORK/coordinator.log") reintento(s))."
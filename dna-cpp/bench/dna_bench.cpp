@@ -0,0 +1,426 @@
+// Banco de pruebas del motor: genera conjuntos sintéticos, ejecuta cada algoritmo con
+// calentamiento y varias repeticiones, y guarda ns/base, GB/s y asignaciones en JSON.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <cstdlib>
+#include <new>
+
+#include "genome_generator.hpp"
+#include "../src/search_engine.hpp"
+#include "../src/parallel_search.hpp"
+#include "../src/fm_index.hpp"
+#include "../src/simd_search.hpp"
+
+// --- Conteo de asignaciones ---
+// Se reemplaza el operador new global de este ejecutable para contar las reservas de
+// memoria que hace cada búsqueda (el motor no se modifica).
+
+static std::atomic<size_t> allocation_count{0};
+static std::atomic<size_t> allocation_bytes{0};
+
+static void* countedAllocate(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+
+// --- Opciones ---
+
+struct BenchOptions {
+    std::vector<size_t> suspects{1, 16};
+    std::vector<size_t> lengths{1000, 1000000, 8000000};
+    std::vector<size_t> pattern_lengths{8, 32};
+    std::vector<double> densities{0, 100};
+    std::vector<double> repeats{0, 0.5};
+    std::vector<std::string> algorithms{"KMP", "RK", "AC", "SIMD", "BP", "ED", "HD", "FM"};
+    int max_errors = 1;
+    int trials = 5;
+    int warmup = 1;
+    unsigned threads = 1;
+    size_t max_bases = 64000000;
+    uint64_t seed = 42;
+    std::string output = "results/benchmark.json";
+    std::string generate_path; // si no está vacío, solo se genera un CSV
+};
+
+// Tamaño con sufijo opcional: 1k = 1000, 1M = 1000000, 1G = 1000000000.
+static bool parseSize(const std::string& text, size_t& value) {
+    if (text.empty()) {
+        return false;
+    }
+    size_t multiplier = 1;
+    std::string digits = text;
+    switch (text.back()) {
+    case 'k': case 'K': multiplier = 1000; digits.pop_back(); break;
+    case 'm': case 'M': multiplier = 1000000; digits.pop_back(); break;
+    case 'g': case 'G': multiplier = 1000000000; digits.pop_back(); break;
+    }
+    if (digits.empty() || digits.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    value = std::stoull(digits) * multiplier;
+    return true;
+}
+
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+static bool parseSizeList(const std::string& text, std::vector<size_t>& values) {
+    values.clear();
+    for (const auto& item : splitList(text)) {
+        size_t value;
+        if (!parseSize(item, value)) {
+            return false;
+        }
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+static bool parseRealList(const std::string& text, std::vector<double>& values) {
+    values.clear();
+    for (const auto& item : splitList(text)) {
+        char* end = nullptr;
+        double value = std::strtod(item.c_str(), &end);
+        if (end == item.c_str() || *end != '\0' || value < 0) {
+            return false;
+        }
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+static bool parseOptions(int argc, char* argv[], BenchOptions& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) {
+            error = "Falta el valor de " + option + ".";
+            return false;
+        }
+        const std::string value = argv[++i];
+        size_t number = 0;
+        bool valid = true;
+        if (option == "--suspects") {
+            valid = parseSizeList(value, options.suspects);
+        } else if (option == "--lengths") {
+            valid = parseSizeList(value, options.lengths);
+        } else if (option == "--pattern-lengths") {
+            valid = parseSizeList(value, options.pattern_lengths);
+        } else if (option == "--densities") {
+            valid = parseRealList(value, options.densities);
+        } else if (option == "--repeats") {
+            valid = parseRealList(value, options.repeats);
+            for (double repeat : options.repeats) {
+                valid = valid && repeat <= 1.0;
+            }
+        } else if (option == "--algorithms") {
+            options.algorithms = splitList(value);
+            for (const auto& algorithm : options.algorithms) {
+                valid = valid && SearchEngine::isValidAlgorithm(algorithm);
+            }
+        } else if (option == "--max-errors") {
+            valid = parseSize(value, number);
+            options.max_errors = number;
+        } else if (option == "--trials") {
+            valid = parseSize(value, number) && number > 0;
+            options.trials = number;
+        } else if (option == "--warmup") {
+            valid = parseSize(value, number);
+            options.warmup = number;
+        } else if (option == "--threads") {
+            valid = parseSize(value, number);
+            options.threads = number;
+        } else if (option == "--max-bases") {
+            valid = parseSize(value, options.max_bases);
+        } else if (option == "--seed") {
+            valid = parseSize(value, number);
+            options.seed = number;
+        } else if (option == "--output") {
+            options.output = value;
+        } else if (option == "--generate") {
+            options.generate_path = value;
+        } else {
+            error = "Opción no reconocida: " + option;
+            return false;
+        }
+        if (!valid) {
+            error = "Valor no válido para " + option + ": " + value;
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Medición ---
+
+struct AlgorithmResult {
+    std::string algorithm;
+    size_t matches = 0;
+    long long preprocess_ns = 0; // construcción del buscador (y del índice, en FM)
+    std::vector<long long> trial_ns;
+    size_t allocations = 0;      // por repetición
+    size_t allocated_bytes = 0;  // por repetición
+};
+
+struct ScenarioResult {
+    GenomeSpec spec;
+    size_t total_bases = 0;
+    size_t planted_matches = 0;
+    std::vector<AlgorithmResult> results;
+};
+
+static long long elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Cuenta las coincidencias a medida que se entregan, sin reunirlas (igual que la salida
+// por flujo de dna_engine).
+template <typename Suspects>
+static size_t countMatches(const SearchEngine& engine, const Suspects& suspects, unsigned threads) {
+    size_t total = 0;
+    searchSuspects(engine, suspects, threads,
+                   [&](size_t, const MatchTable& matches) { total += matches.positions.size(); });
+    return total;
+}
+
+static long long medianNs(std::vector<long long> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// Ejecuta 'search' con calentamiento y repeticiones; cada llamada devuelve las coincidencias.
+static void measure(const BenchOptions& options, const std::function<size_t()>& search, AlgorithmResult& result) {
+    for (int w = 0; w < options.warmup; ++w) {
+        result.matches = search();
+    }
+    size_t allocations = 0;
+    size_t bytes = 0;
+    for (int t = 0; t < options.trials; ++t) {
+        size_t count_before = allocation_count.load(std::memory_order_relaxed);
+        size_t bytes_before = allocation_bytes.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        result.matches = search();
+        result.trial_ns.push_back(elapsedNs(start));
+        allocations += allocation_count.load(std::memory_order_relaxed) - count_before;
+        bytes += allocation_bytes.load(std::memory_order_relaxed) - bytes_before;
+    }
+    result.allocations = allocations / options.trials;
+    result.allocated_bytes = bytes / options.trials;
+}
+
+static ScenarioResult runScenario(const BenchOptions& options, const GenomeSpec& spec) {
+    ScenarioResult scenario;
+    scenario.spec = spec;
+    scenario.total_bases = spec.suspects * spec.length;
+
+    const SyntheticGenome genome = generateGenome(spec);
+    scenario.planted_matches = genome.planted_matches;
+    const std::vector<std::string> patterns{genome.pattern};
+
+    // Representaciones que se preparan una sola vez por escenario y solo si se usan.
+    PackedSuspectList packed;
+    std::vector<SuspectView> views;
+
+    for (const auto& algorithm : options.algorithms) {
+        AlgorithmResult result;
+        result.algorithm = algorithm;
+
+        if (algorithm == "FM") {
+            if (views.empty()) {
+                for (const auto& suspect : genome.suspects) {
+                    views.push_back({suspect.first, suspect.second, true});
+                }
+            }
+            FMIndex index;
+            auto start = std::chrono::steady_clock::now();
+            if (!index.build(views, 0, 0)) {
+                continue;
+            }
+            result.preprocess_ns = elapsedNs(start);
+            std::vector<std::vector<int64_t>> positions;
+            measure(options, [&]() {
+                index.locate(genome.pattern, positions);
+                size_t total = 0;
+                for (const auto& list : positions) {
+                    total += list.size();
+                }
+                return total;
+            }, result);
+        } else {
+            const int max_errors = (algorithm == "ED" || algorithm == "HD") ? options.max_errors : 0;
+            if (max_errors >= static_cast<int>(genome.pattern.length())) {
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            const SearchEngine engine(algorithm, patterns, max_errors);
+            result.preprocess_ns = elapsedNs(start);
+
+            if (engine.usesPackedInput() && packed.empty()) {
+                for (const auto& suspect : genome.suspects) {
+                    packed.push_back({suspect.first, packSequence(suspect.second)});
+                }
+            }
+            const unsigned threads = resolveThreadCount(options.threads);
+            measure(options, [&]() {
+                return engine.usesPackedInput() ? countMatches(engine, packed, threads)
+                                                : countMatches(engine, genome.suspects, threads);
+            }, result);
+        }
+        scenario.results.push_back(std::move(result));
+    }
+    return scenario;
+}
+
+// --- Salida ---
+
+static void writeReport(std::ostream& out, const BenchOptions& options, const std::vector<ScenarioResult>& scenarios) {
+    out << "{\n";
+    out << "  \"benchmark\": \"dna_engine\",\n";
+    out << "  \"seed\": " << options.seed << ",\n";
+    out << "  \"trials\": " << options.trials << ",\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"threads\": " << resolveThreadCount(options.threads) << ",\n";
+    out << "  \"max_errors\": " << options.max_errors << ",\n";
+    out << "  \"simd_level\": \"" << simdLevelName(activeSimdLevel()) << "\",\n";
+    out << "  \"scenarios\": [\n";
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        const ScenarioResult& scenario = scenarios[i];
+        out << "    {\n";
+        out << "      \"suspects\": " << scenario.spec.suspects << ",\n";
+        out << "      \"length\": " << scenario.spec.length << ",\n";
+        out << "      \"pattern_length\": " << scenario.spec.pattern_length << ",\n";
+        out << "      \"match_density\": " << scenario.spec.match_density << ",\n";
+        out << "      \"repetitiveness\": " << scenario.spec.repetitiveness << ",\n";
+        out << "      \"total_bases\": " << scenario.total_bases << ",\n";
+        out << "      \"planted_matches\": " << scenario.planted_matches << ",\n";
+        out << "      \"results\": [\n";
+        for (size_t j = 0; j < scenario.results.size(); ++j) {
+            const AlgorithmResult& result = scenario.results[j];
+            const long long median = medianNs(result.trial_ns);
+            const double bases = static_cast<double>(scenario.total_bases);
+            out << "        {\"algorithm\": \"" << result.algorithm << "\""
+                << ", \"matches\": " << result.matches
+                << ", \"preprocess_ns\": " << result.preprocess_ns
+                << ", \"min_ns\": " << *std::min_element(result.trial_ns.begin(), result.trial_ns.end())
+                << ", \"median_ns\": " << median
+                << ", \"ns_per_base\": " << (bases > 0 ? median / bases : 0.0)
+                << ", \"gb_per_s\": " << (median > 0 ? bases / median : 0.0)
+                << ", \"allocations\": " << result.allocations
+                << ", \"allocated_bytes\": " << result.allocated_bytes
+                << ", \"trials_ns\": [";
+            for (size_t t = 0; t < result.trial_ns.size(); ++t) {
+                out << result.trial_ns[t] << (t + 1 < result.trial_ns.size() ? ", " : "");
+            }
+            out << "]}" << (j + 1 < scenario.results.size() ? ",\n" : "\n");
+        }
+        out << "      ]\n";
+        out << "    }" << (i + 1 < scenarios.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    std::string error;
+    if (!parseOptions(argc, argv, options, error)) {
+        std::cerr << "ERROR: " << error << std::endl;
+        std::cerr << "Uso: " << argv[0] << " [--suspects 1,16] [--lengths 1k,1M,100M] [--pattern-lengths 8,32]"
+                  << " [--densities 0,100] [--repeats 0,0.5] [--algorithms KMP,RK,AC,SIMD,BP,ED,HD,FM]"
+                  << " [--max-errors K] [--trials N] [--warmup N] [--threads N] [--max-bases 64M]"
+                  << " [--seed S] [--output ruta_json] [--generate ruta_csv]" << std::endl;
+        return 1;
+    }
+
+    // Solo generar: el primer valor de cada lista define el conjunto.
+    if (!options.generate_path.empty()) {
+        GenomeSpec spec;
+        spec.suspects = options.suspects[0];
+        spec.length = options.lengths[0];
+        spec.pattern_length = options.pattern_lengths[0];
+        spec.match_density = options.densities[0];
+        spec.repetitiveness = options.repeats[0];
+        spec.seed = options.seed;
+        const SyntheticGenome genome = generateGenome(spec);
+        if (!writeGenomeCSV(options.generate_path, genome)) {
+            return 1;
+        }
+        std::cout << "SUCCESS: " << genome.suspects.size() << " sospechosos generados en "
+                  << options.generate_path << ". PATTERN: " << genome.pattern << std::endl;
+        return 0;
+    }
+
+    std::vector<ScenarioResult> scenarios;
+    for (size_t suspects : options.suspects) {
+        for (size_t length : options.lengths) {
+            if (suspects * length > options.max_bases) {
+                std::cerr << "ADVERTENCIA: Se omite " << suspects << " x " << length
+                          << " bases (supera --max-bases)." << std::endl;
+                continue;
+            }
+            for (size_t pattern_length : options.pattern_lengths) {
+                for (double density : options.densities) {
+                    for (double repeat : options.repeats) {
+                        GenomeSpec spec;
+                        spec.suspects = suspects;
+                        spec.length = length;
+                        spec.pattern_length = pattern_length;
+                        spec.match_density = density;
+                        spec.repetitiveness = repeat;
+                        spec.seed = options.seed;
+
+                        ScenarioResult scenario = runScenario(options, spec);
+                        for (const auto& result : scenario.results) {
+                            const long long median = medianNs(result.trial_ns);
+                            std::cout << suspects << "x" << length << " m=" << pattern_length
+                                      << " densidad=" << density << " repeticion=" << repeat << "  "
+                                      << result.algorithm << ": "
+                                      << static_cast<double>(median) / scenario.total_bases << " ns/base, "
+                                      << result.matches << " coincidencias, "
+                                      << result.allocations << " asignaciones" << std::endl;
+                        }
+                        scenarios.push_back(std::move(scenario));
+                    }
+                }
+            }
+        }
+    }
+
+    std::ofstream report(options.output);
+    if (!report.is_open()) {
+        std::cerr << "ERROR: No se pudo crear el archivo de resultados en la ruta: " << options.output << std::endl;
+        return 1;
+    }
+    writeReport(report, options, scenarios);
+    std::cout << "SUCCESS: " << scenarios.size() << " escenarios guardados en " << options.output << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "genome_generator.hpp"
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+static const char BASES[] = {'A', 'C', 'G', 'T'};
+
+// Longitud de cada tramo que puede convertirse en repetición en tándem.
+const size_t TANDEM_BLOCK_LENGTH = 1024;
+
+static void fillRandom(std::string& sequence, size_t begin, size_t end, std::mt19937_64& rng) {
+    // 32 bases por cada número aleatorio de 64 bits
+    uint64_t bits = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if ((i - begin) % 32 == 0) {
+            bits = rng();
+        }
+        sequence[i] = BASES[bits & 3];
+        bits >>= 2;
+    }
+}
+
+static void fillTandem(std::string& sequence, size_t begin, size_t end, const std::string& unit) {
+    for (size_t i = begin; i < end; ++i) {
+        sequence[i] = unit[i % unit.length()]; // la fase continúa entre tramos contiguos
+    }
+}
+
+SyntheticGenome generateGenome(const GenomeSpec& spec) {
+    std::mt19937_64 rng(spec.seed);
+    std::uniform_real_distribution<double> probability(0.0, 1.0);
+    SyntheticGenome genome;
+
+    std::string unit;
+    if (spec.repetitiveness > 0.0) {
+        unit.resize(2 + rng() % 5); // unidad de 2 a 6 bases
+        fillRandom(unit, 0, unit.length(), rng);
+        genome.pattern.resize(spec.pattern_length);
+        fillTandem(genome.pattern, 0, spec.pattern_length, unit);
+        if (!genome.pattern.empty()) {
+            char& last = genome.pattern.back();
+            last = last == 'A' ? 'C' : 'A';
+        }
+    } else {
+        genome.pattern.resize(spec.pattern_length);
+        fillRandom(genome.pattern, 0, spec.pattern_length, rng);
+    }
+
+    const double expected_matches = spec.match_density * spec.length / 1e6;
+    genome.suspects.reserve(spec.suspects);
+    for (size_t s = 0; s < spec.suspects; ++s) {
+        std::string sequence(spec.length, 'A');
+        for (size_t begin = 0; begin < spec.length; begin += TANDEM_BLOCK_LENGTH) {
+            size_t end = std::min(spec.length, begin + TANDEM_BLOCK_LENGTH);
+            if (!unit.empty() && probability(rng) < spec.repetitiveness) {
+                fillTandem(sequence, begin, end, unit);
+            } else {
+                fillRandom(sequence, begin, end, rng);
+            }
+        }
+
+        // Coincidencias plantadas: la parte entera del valor esperado más una con la probabilidad restante.
+        if (!genome.pattern.empty() && spec.pattern_length <= spec.length) {
+            size_t planted = static_cast<size_t>(expected_matches);
+            if (probability(rng) < expected_matches - planted) {
+                ++planted;
+            }
+            for (size_t k = 0; k < planted; ++k) {
+                size_t position = rng() % (spec.length - spec.pattern_length + 1);
+                sequence.replace(position, spec.pattern_length, genome.pattern);
+            }
+            genome.planted_matches += planted;
+        }
+
+        genome.suspects.emplace_back("Sospechoso_" + std::to_string(s + 1), std::move(sequence));
+    }
+    return genome;
+}
+
+bool writeGenomeCSV(const std::string& filename, const SyntheticGenome& genome) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: No se pudo crear el archivo CSV en la ruta: " << filename << std::endl;
+        return false;
+    }
+    file << "Nombre,Cadena_ADN\n";
+    for (const auto& suspect : genome.suspects) {
+        file << suspect.first << ',' << suspect.second << '\n';
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,38 @@
+#ifndef GENOME_GENERATOR_HPP
+#define GENOME_GENERATOR_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "../src/csv_reader.hpp"
+
+// Parámetros de un conjunto de datos sintético.
+struct GenomeSpec {
+    size_t suspects = 1;
+    size_t length = 1000;         // bases por sospechoso
+    size_t pattern_length = 16;
+    double match_density = 0.0;   // coincidencias plantadas por millón de bases
+    double repetitiveness = 0.0;  // fracción (0-1) de cada secuencia formada por repeticiones en tándem
+    uint64_t seed = 42;
+};
+
+// Conjunto generado: los sospechosos y el patrón que se busca en ellos.
+struct SyntheticGenome {
+    SuspectList suspects;
+    std::string pattern;
+    size_t planted_matches = 0;
+};
+
+// Genera secuencias aleatorias reproducibles (misma semilla, mismos datos).
+// Las repeticiones en tándem usan una unidad corta, y en ese caso el patrón es la misma
+// unidad repetida con la última base cambiada: cada repetición produce coincidencias
+// parciales de m - 1 bases, el peor caso para los retrocesos de KMP, los enlaces de
+// fallo de AC y las verificaciones de RK. Las coincidencias se plantan copiando el
+// patrón en posiciones aleatorias.
+SyntheticGenome generateGenome(const GenomeSpec& spec);
+
+// Escribe el conjunto en formato CSV (Nombre,Cadena_ADN) para usarlo con dna_engine.
+bool writeGenomeCSV(const std::string& filename, const SyntheticGenome& genome);
+
+#endif
@@ -0,0 +1,408 @@
+#include "coordinator.hpp"
+#include "server.hpp"
+#include "socket_io.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "../src/mapped_csv.hpp"
+#include "../src/sequence_stream.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+// Ruta absoluta, para que un trabajador con otra carpeta de trabajo vea el mismo archivo.
+static std::string absolutePath(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    return error ? path : absolute.string();
+}
+
+static std::string rangeText(const Shard& shard) {
+    return std::to_string(shard.begin) + ":" + std::to_string(shard.end);
+}
+
+// --- Procesos locales ---
+
+ProcessTransport::ProcessTransport(const std::string& executable) : executable(executable) {}
+
+// Identificador del proceso, para que dos coordinadores no compartan archivos temporales.
+static long processId() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<long>(getpid());
+#endif
+}
+
+#ifdef _WIN32
+// _spawnvp une los argumentos con espacios: cada uno se pasa entre comillas, con las reglas
+// de CommandLineToArgvW para las comillas y las barras invertidas que las preceden.
+static std::string quoteArgument(const std::string& argument) {
+    if (!argument.empty() && argument.find_first_of(" \t\"") == std::string::npos) {
+        return argument;
+    }
+    std::string quoted = "\"";
+    size_t backslashes = 0;
+    for (char c : argument) {
+        if (c == '\\') {
+            ++backslashes;
+            continue;
+        }
+        quoted.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+        backslashes = 0;
+        quoted += c;
+    }
+    quoted.append(backslashes * 2, '\\');
+    quoted += '"';
+    return quoted;
+}
+#endif
+
+// Ejecuta el trabajador y espera a que termine. Retorna false, con el motivo en 'error', si
+// no se pudo iniciar o si no terminó normalmente; 'exit_code' queda con su código de salida.
+static bool runWorkerProcess(const std::string& executable, const std::vector<std::string>& arguments,
+                             int& exit_code, std::string& error) {
+#ifdef _WIN32
+    std::vector<std::string> quoted;
+    quoted.push_back(quoteArgument(executable));
+    for (const auto& argument : arguments) {
+        quoted.push_back(quoteArgument(argument));
+    }
+    std::vector<const char*> argv;
+    for (const auto& argument : quoted) {
+        argv.push_back(argument.c_str());
+    }
+    argv.push_back(nullptr);
+    const intptr_t status = _spawnvp(_P_WAIT, executable.c_str(), argv.data());
+    if (status == -1) {
+        error = "no se pudo iniciar " + executable;
+        return false;
+    }
+    exit_code = static_cast<int>(status);
+    return true;
+#else
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(executable.c_str()));
+    for (const auto& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    // La salida estándar del trabajador (SUCCESS:, TIME_MS:) no le sirve al coordinador.
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    pid_t pid = 0;
+    const int spawned = posix_spawnp(&pid, executable.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (spawned != 0) {
+        error = "no se pudo iniciar " + executable;
+        return false;
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            error = "no se pudo esperar al trabajador";
+            return false;
+        }
+    }
+    if (WIFSIGNALED(status)) {
+        error = "el trabajador terminó por la señal " + std::to_string(WTERMSIG(status));
+        return false;
+    }
+    exit_code = WEXITSTATUS(status);
+    return true;
+#endif
+}
+
+bool ProcessTransport::run(const SearchRequest& request, const Shard& shard, unsigned slot, std::string& output,
+                           std::string& error) {
+    static std::atomic<unsigned long> attempt_counter{0};
+    std::error_code path_error;
+    std::filesystem::path directory = std::filesystem::temp_directory_path(path_error);
+    if (path_error) {
+        directory = ".";
+    }
+    const std::string output_path =
+        (directory / ("dna-shard-" + std::to_string(processId()) + "-" + std::to_string(slot) + "-" +
+                      std::to_string(attempt_counter++) + ".bin")).string();
+
+    const SearchOptions& options = request.options;
+    std::vector<std::string> arguments = {request.csv_path, request.pattern, request.algorithm, output_path,
+                                          "--range", rangeText(shard), "--format", "binary",
+                                          "--threads", std::to_string(options.threads)};
+    if (options.max_errors > 0) {
+        arguments.push_back("--max-errors");
+        arguments.push_back(std::to_string(options.max_errors));
+    }
+    if (options.both_strands) {
+        arguments.push_back("--both-strands");
+    }
+    if (options.query.mode != QueryMode::ALL) {
+        arguments.push_back("--query");
+        arguments.push_back(queryName(options.query));
+    }
+
+    int exit_code = 0;
+    const bool finished = runWorkerProcess(executable, arguments, exit_code, error);
+    // Un trabajador que termina con error igual escribe el documento con el motivo.
+    bool read = false;
+    if (finished) {
+        std::ifstream in(output_path, std::ios::binary);
+        if (in.is_open()) {
+            output.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            read = true;
+        } else {
+            error = "el trabajador terminó con código " + std::to_string(exit_code) + " sin escribir resultados";
+        }
+    }
+    std::remove(output_path.c_str());
+    return read;
+}
+
+// --- Servidores (dna_engine --server) ---
+
+SocketTransport::SocketTransport(const std::vector<std::string>& socket_paths) : socket_paths(socket_paths) {
+    initSockets();
+}
+
+bool SocketTransport::run(const SearchRequest& request, const Shard& shard, unsigned slot, std::string& output,
+                          std::string& error) {
+    const std::string& socket_path = socket_paths[slot % socket_paths.size()];
+    const SearchOptions& options = request.options;
+    std::ostringstream message;
+    message << "csv=" << absolutePath(request.csv_path) << "\n"
+            << "algorithm=" << request.algorithm << "\n";
+    if (!request.panel.empty()) {
+        for (const auto& entry : request.panel) {
+            message << "pattern=" << entry.first << "," << entry.second << "\n";
+        }
+    } else if (!request.pattern.empty() && request.pattern[0] == '@') {
+        message << "pattern=@" << absolutePath(request.pattern.substr(1)) << "\n";
+    } else {
+        message << "pattern=" << request.pattern << "\n";
+    }
+    message << "threads=" << options.threads << "\n"
+            << "range=" << rangeText(shard) << "\n"
+            << "format=binary\n";
+    if (options.max_errors > 0) {
+        message << "max_errors=" << options.max_errors << "\n";
+    }
+    if (options.both_strands) {
+        message << "both_strands=1\n";
+    }
+    if (options.query.mode != QueryMode::ALL) {
+        message << "query=" << queryName(options.query) << "\n";
+    }
+
+    socket_t server = connectSocket(socket_path);
+    if (server == INVALID_SOCKET_HANDLE) {
+        error = "no se pudo conectar a " + socket_path;
+        return false;
+    }
+    const bool answered = writeMessage(server, message.str(), MAX_REQUEST_BYTES) &&
+                          readMessage(server, output, MAX_RESPONSE_BYTES);
+    closeSocket(server);
+    if (!answered) {
+        error = "se perdió la conexión con " + socket_path;
+    }
+    return answered;
+}
+
+// --- Coordinador ---
+
+static SearchOutcome failure(const std::string& message) {
+    SearchOutcome outcome;
+    outcome.success = false;
+    outcome.message = message;
+    return outcome;
+}
+
+// Entrega los sospechosos al sink o, sin sink, los guarda en outcome.results.
+static void deliver(ResultEntry& entry, SearchOutcome& outcome, ResultSink* sink, long long& sink_ns) {
+    ++outcome.suspect_count;
+    if (sink) {
+        PhaseTimer sink_timer;
+        sink->write(entry);
+        sink_ns += sink_timer.elapsedNs();
+    } else {
+        outcome.results.push_back(std::move(entry));
+    }
+}
+
+SearchOutcome runCoordinator(const SearchRequest& request, const CoordinatorOptions& options,
+                             ShardTransport& transport, ResultSink* sink) {
+    PhaseTimer total_timer;
+    if (!SearchEngine::isValidAlgorithm(request.algorithm)) {
+        std::cerr << "ERROR: Algoritmo no reconocido: " << request.algorithm << std::endl;
+        return failure("Algoritmo no reconocido.");
+    }
+    if (request.algorithm == "FM" || request.options.stream || !request.csv_data.empty() ||
+        request.options.range_end != 0 || detectSequenceFormat(request.csv_path) != SequenceFormat::CSV) {
+        return failure("El modo coordinador reparte un CSV en disco completo; no admite FM, lectura por fragmentos "
+                       "ni FASTA/FASTQ.");
+    }
+    if (options.workers == 0) {
+        return failure("El modo coordinador necesita al menos un trabajador.");
+    }
+
+    // Plan: límites de los fragmentos, alineados al inicio de un registro.
+    SearchMetrics metrics;
+    PhaseTimer plan_timer;
+    std::vector<uint64_t> bounds;
+    {
+        MappedFile file;
+        if (!file.open(request.csv_path)) {
+            return failure("Fallo al leer o validar el archivo CSV.");
+        }
+        const size_t shard_count = options.shards > 0 ? options.shards : size_t(options.workers) * SHARDS_PER_WORKER;
+        bounds = splitCSVRecords(std::string_view(file.data(), file.size()), shard_count);
+    }
+    metrics.load_ns = plan_timer.elapsedNs();
+    std::vector<Shard> shards;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        shards.push_back({i, bounds[i], bounds[i + 1]});
+    }
+    const uint64_t total_bytes = bounds.empty() ? 0 : bounds.back();
+
+    SearchOutcome outcome;
+    const bool top = request.options.query.mode == QueryMode::TOP;
+    long long sink_ns = 0;
+    uint64_t worker_peak_rss = 0;
+
+    // Cada trabajador deja su fragmento en 'done'; el que completa el prefijo en orden
+    // entrega sus sospechosos (con top, se reúnen para ordenarlos al final).
+    std::mutex mutex;
+    std::vector<BinaryResults> done(shards.size());
+    std::vector<char> finished(shards.size(), 0);
+    std::vector<ResultEntry> ranking;
+    size_t next_delivery = 0;
+    size_t done_count = 0;
+    uint64_t done_bytes = 0;
+    bool failed = false;
+    std::string failure_message;
+    std::atomic<size_t> next_shard{0};
+
+    auto work = [&](unsigned slot) {
+        for (size_t t = next_shard++; t < shards.size(); t = next_shard++) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (failed) {
+                    return;
+                }
+            }
+            const Shard& shard = shards[t];
+            BinaryResults results;
+            bool answered = false;
+            std::string error;
+            for (unsigned attempt = 0; attempt <= options.retries && !answered; ++attempt) {
+                std::string output;
+                error.clear();
+                // Cada intento va al trabajador siguiente: un trabajador caído no agota los reintentos.
+                answered = transport.run(request, shard, slot + attempt, output, error) &&
+                           readBinaryResults(output, results);
+                if (!answered) {
+                    if (error.empty()) {
+                        error = "respuesta incompleta o dañada";
+                    }
+                    std::cerr << "ADVERTENCIA: Falló el fragmento " << t + 1 << "/" << shards.size() << " ("
+                              << error << ")" << (attempt < options.retries ? "; se reintenta." : ".") << std::endl;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (failed) {
+                return;
+            }
+            if (!answered || !results.success) {
+                // Una búsqueda que informa un error (patrón, panel...) fallaría igual en otro intento.
+                failed = true;
+                failure_message = answered ? results.message
+                                           : "El fragmento " + std::to_string(t + 1) + " falló tras " +
+                                                 std::to_string(options.retries + 1) + " intento(s): " + error;
+                return;
+            }
+            addCounterFields(metrics.counters, results.metrics);
+            for (const auto& field : results.metrics) {
+                if (field.first == "peak_rss_bytes") {
+                    worker_peak_rss = std::max(worker_peak_rss, field.second);
+                }
+            }
+            done[t] = std::move(results);
+            finished[t] = 1;
+            ++done_count;
+            done_bytes += shard.end - shard.begin;
+            while (next_delivery < shards.size() && finished[next_delivery]) {
+                for (ResultEntry& entry : done[next_delivery].suspects) {
+                    if (top) {
+                        ranking.push_back(std::move(entry));
+                    } else {
+                        deliver(entry, outcome, sink, sink_ns);
+                    }
+                }
+                done[next_delivery] = BinaryResults();
+                ++next_delivery;
+            }
+            if (options.progress) {
+                options.progress(done_count, shards.size(), done_bytes, total_bytes);
+            }
+        }
+    };
+
+    const unsigned thread_count = static_cast<unsigned>(std::min<size_t>(options.workers, shards.size()));
+    std::vector<std::thread> threads;
+    for (unsigned slot = 1; slot < thread_count; ++slot) {
+        threads.emplace_back(work, slot);
+    }
+    work(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failed) {
+        outcome.success = false;
+        outcome.message = failure_message;
+        return outcome;
+    }
+
+    // Top: cada fragmento trae sus K mejores ya ordenados y se reunieron en el orden del CSV,
+    // así que un orden estable por coincidencias desempata igual que una búsqueda única.
+    if (top) {
+        std::stable_sort(ranking.begin(), ranking.end(),
+                         [](const ResultEntry& a, const ResultEntry& b) { return a.matches > b.matches; });
+        if (ranking.size() > request.options.query.limit) {
+            ranking.resize(request.options.query.limit);
+        }
+        for (ResultEntry& entry : ranking) {
+            deliver(entry, outcome, sink, sink_ns);
+        }
+    }
+
+    const long long total_ns = total_timer.elapsedNs();
+    metrics.serialize_ns = sink_ns;
+    metrics.search_ns = total_ns - metrics.load_ns - sink_ns;
+    metrics.peak_rss_bytes = std::max(peakResidentBytes(), worker_peak_rss);
+    outcome.metrics = metrics;
+    outcome.duration_ms = total_ns / 1000000;
+    outcome.success = true;
+    outcome.message = "Búsqueda exitosa con " + request.algorithm + " en " + std::to_string(shards.size()) +
+                      " fragmento(s). Se encontraron coincidencias en " + std::to_string(outcome.suspect_count) +
+                      " sospechoso(s).";
+    return outcome;
+}
@@ -0,0 +1,88 @@
+#ifndef COORDINATOR_HPP
+#define COORDINATOR_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include "../src/search_service.hpp"
+#include "../src/result_writer.hpp"
+
+// Fragmento del CSV: los registros completos del rango de bytes [begin, end).
+struct Shard {
+    size_t index;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Forma de hacer llegar un fragmento a un trabajador. El coordinador solo conoce esta
+// interfaz, así que los trabajadores pueden ser procesos locales, servidores en otras
+// máquinas u otra implementación sin cambiar el reparto, los reintentos ni la unión de los
+// resultados. 'run' se llama desde varios hilos a la vez.
+class ShardTransport {
+public:
+    virtual ~ShardTransport() = default;
+
+    // Busca 'request' solo en el fragmento y deja en 'output' el documento binario
+    // (OutputFormat::BINARY) que respondió el trabajador, aunque informe un error de la
+    // búsqueda. 'slot' elige el trabajador: el hilo del coordinador que hace la llamada (0 a
+    // workers - 1) más el número de intento, así un reintento va a otro trabajador si hay
+    // varios. Retorna false, con el motivo en 'error', si no hubo respuesta completa.
+    virtual bool run(const SearchRequest& request, const Shard& shard, unsigned slot, std::string& output,
+                     std::string& error) = 0;
+};
+
+// Un proceso 'executable' (el mismo dna_engine) por fragmento, con --range y la salida binaria
+// en un archivo temporal. La salida estándar del trabajador se descarta.
+class ProcessTransport : public ShardTransport {
+public:
+    explicit ProcessTransport(const std::string& executable);
+
+    bool run(const SearchRequest& request, const Shard& shard, unsigned slot, std::string& output,
+             std::string& error) override;
+
+private:
+    std::string executable;
+};
+
+// Envía cada fragmento a un servidor (dna_engine --server) con la clave range=. Cada intento
+// usa el socket 'slot' módulo la cantidad de sockets, y una conexión por fragmento.
+// Los servidores deben ver el CSV (y el archivo de panel) en la misma ruta absoluta, p. ej. en
+// un almacenamiento compartido; un socket local puede reenviarse a otra máquina (ssh -L).
+class SocketTransport : public ShardTransport {
+public:
+    explicit SocketTransport(const std::vector<std::string>& socket_paths);
+
+    bool run(const SearchRequest& request, const Shard& shard, unsigned slot, std::string& output,
+             std::string& error) override;
+
+private:
+    std::vector<std::string> socket_paths;
+};
+
+struct CoordinatorOptions {
+    unsigned workers = 0;    // fragmentos en curso a la vez (0 = uno por socket de worker_sockets)
+    size_t shards = 0;       // fragmentos en que se divide el CSV (0 = SHARDS_PER_WORKER por trabajador)
+    unsigned retries = 2;    // intentos extra de un fragmento cuyo trabajador falló
+    std::vector<std::string> worker_sockets; // vacío = procesos locales
+    // Se llama cada vez que termina un fragmento, con los fragmentos y bytes terminados y los
+    // totales. Las llamadas nunca se solapan.
+    std::function<void(size_t done, size_t total, uint64_t done_bytes, uint64_t total_bytes)> progress;
+};
+
+// Fragmentos por trabajador si no se indica --shards: los trabajadores que terminan antes
+// toman más, y un reintento repite menos trabajo.
+const size_t SHARDS_PER_WORKER = 4;
+
+// Modo coordinador: divide el CSV en fragmentos alineados a registros, los reparte entre
+// options.workers trabajadores a través de 'transport' y entrega los sospechosos de todos al
+// sink en el orden del CSV, en cuanto están listos los fragmentos anteriores (con la consulta
+// top, al final y de más a menos coincidencias). Un fragmento cuyo trabajador falla se
+// reintenta hasta options.retries veces; si la búsqueda misma informa un error, no se reintenta.
+// Los contadores de las métricas son la suma de los trabajadores.
+SearchOutcome runCoordinator(const SearchRequest& request, const CoordinatorOptions& options,
+                             ShardTransport& transport, ResultSink* sink);
+
+#endif
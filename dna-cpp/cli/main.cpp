@@ -0,0 +1,247 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+
+#include "../src/search_service.hpp"
+#include "server.hpp"
+#include "coordinator.hpp"
+#include "../src/json_output.hpp"
+#include "../src/result_writer.hpp"
+#include "../src/fm_index.hpp"
+
+// Lee las opciones a partir de argv[first]. Devuelve false y describe el problema en 'error'.
+static bool parseOptions(int argc, char* argv[], int first, SearchOptions& options, bool& print_metrics,
+                         OutputFormat& format, CoordinatorOptions& coordinator, std::string& error) {
+    for (int i = first; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option == "--metrics") {
+            print_metrics = true;
+        } else if (option == "--format") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --format.";
+                return false;
+            }
+            if (!parseOutputFormat(argv[++i], format)) {
+                error = "El valor de --format debe ser json, ndjson o binary.";
+                return false;
+            }
+        } else if (option == "--query") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --query.";
+                return false;
+            }
+            if (!parseQuery(argv[++i], options.query)) {
+                error = "El valor de --query debe ser all, exists, count, first=N o top=K.";
+                return false;
+            }
+        } else if (option == "--range") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --range.";
+                return false;
+            }
+            if (!parseByteRange(argv[++i], options)) {
+                error = "El valor de --range debe ser B:E con B < E (bytes del CSV).";
+                return false;
+            }
+        } else if (option == "--workers" || option == "--shards" || option == "--retries") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de " + option + ".";
+                return false;
+            }
+            size_t count = 0;
+            if (!parseCount(argv[++i], count) || (count == 0 && option != "--retries")) {
+                error = "El valor de " + option + (option == "--retries" ? " debe ser un entero no negativo."
+                                                                          : " debe ser un entero positivo.");
+                return false;
+            }
+            if (option == "--workers") {
+                coordinator.workers = static_cast<unsigned>(count);
+            } else if (option == "--shards") {
+                coordinator.shards = count;
+            } else {
+                coordinator.retries = static_cast<unsigned>(count);
+            }
+        } else if (option == "--worker-socket") {
+            if (i + 1 >= argc) {
+                error = "Falta la ruta de --worker-socket.";
+                return false;
+            }
+            coordinator.worker_sockets.push_back(argv[++i]);
+        } else if (option == "--both-strands") {
+            options.both_strands = true;
+        } else if (option == "--kmer-filter") {
+            options.kmer_filter = true;
+        } else if (option == "--stream") {
+            options.stream = true;
+        } else if (option == "--chunk-size") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --chunk-size.";
+                return false;
+            }
+            options.chunk_size = parseSize(argv[++i]);
+            if (options.chunk_size == 0) {
+                error = "El valor de --chunk-size debe ser un entero positivo (admite K, M o G).";
+                return false;
+            }
+        } else if (option == "--pipeline-depth") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --pipeline-depth.";
+                return false;
+            }
+            if (!parseCount(argv[++i], options.pipeline_depth) || options.pipeline_depth == 0) {
+                error = "El valor de --pipeline-depth debe ser un entero positivo.";
+                return false;
+            }
+        } else if (option == "--result-cache") {
+            if (i + 1 >= argc) {
+                error = "Falta la carpeta de --result-cache.";
+                return false;
+            }
+            options.result_cache_dir = argv[++i];
+        } else if (option == "--result-cache-limit") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --result-cache-limit.";
+                return false;
+            }
+            options.result_cache_limit = parseSize(argv[++i]);
+            if (options.result_cache_limit == 0) {
+                error = "El valor de --result-cache-limit debe ser un entero positivo (admite K, M o G).";
+                return false;
+            }
+        } else if (option == "--threads") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --threads.";
+                return false;
+            }
+            size_t threads = 0;
+            if (!parseCount(argv[++i], threads)) {
+                error = "El valor de --threads debe ser un entero no negativo.";
+                return false;
+            }
+            options.threads = static_cast<unsigned>(threads);
+        } else if (option == "--max-errors") {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de --max-errors.";
+                return false;
+            }
+            size_t max_errors = 0;
+            if (!parseCount(argv[++i], max_errors)) {
+                error = "El valor de --max-errors debe ser un entero no negativo.";
+                return false;
+            }
+            options.max_errors = static_cast<int>(max_errors);
+        } else {
+            error = "Opción no reconocida: " + option;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Número de CSV que el modo servidor conserva en memoria si no se indica --cache.
+const size_t DEFAULT_SERVER_CACHE = 8;
+
+int main(int argc, char* argv[]) {
+
+    // Modo servidor: dna_engine --server <ruta_socket> [--cache N]
+    if (argc >= 2 && std::string(argv[1]) == "--server") {
+        size_t cache_capacity = DEFAULT_SERVER_CACHE;
+        const bool valid = argc == 3 ||
+                           (argc == 5 && std::string(argv[3]) == "--cache" && parseCount(argv[4], cache_capacity));
+        if (!valid) {
+            std::cerr << "Uso: " << argv[0] << " --server <ruta_socket> [--cache N]" << std::endl;
+            return 1;
+        }
+        return runServer(argv[2], cache_capacity);
+    }
+
+    // Construcción del índice FM: dna_engine --build-index <ruta_csv>
+    // Deja listo <ruta_csv>.fmi para que las búsquedas con FM no lo construyan al vuelo.
+    if (argc >= 2 && std::string(argv[1]) == "--build-index") {
+        if (argc != 3) {
+            std::cerr << "Uso: " << argv[0] << " --build-index <ruta_csv>" << std::endl;
+            return 1;
+        }
+        FMIndex index;
+        if (!loadOrBuildFMIndex(argv[2], index)) {
+            return 1;
+        }
+        std::cout << "SUCCESS: Índice FM listo en " << fmIndexPath(argv[2]) << " ("
+                  << index.suspectCount() << " sospechosos)." << std::endl;
+        return 0;
+    }
+    
+    // 1. Manejo de Argumentos 
+    if (argc < 5) { 
+        std::cerr << "Uso: " << argv[0] << " <ruta_csv> <patron_adn|@archivo_patrones> <algoritmo> <ruta_salida_json>"
+                  << " [--threads N] [--max-errors K] [--both-strands] [--kmer-filter] [--stream] [--chunk-size N] [--pipeline-depth N]"
+                  << " [--query exists|count|first=N|top=K] [--result-cache DIR] [--result-cache-limit N] [--format json|ndjson|binary] [--metrics]"
+                  << " [--workers N] [--worker-socket RUTA]... [--shards N] [--retries N] [--range B:E]" << std::endl;
+        std::cerr << "     " << argv[0] << " --server <ruta_socket> [--cache N]" << std::endl;
+        std::cerr << "     " << argv[0] << " --build-index <ruta_csv>" << std::endl;
+        generateJSONOutput("dna-cpp/results/error.json", false, "Argumentos incompletos o incorrectos.", "None", {}, 0);
+        return 1;
+    }
+    
+    SearchRequest request;
+    request.csv_path = argv[1];
+    request.pattern = argv[2];
+    request.algorithm = argv[3]; 
+    const std::string json_output_path = argv[4];
+
+    std::string option_error;
+    bool print_metrics = false;
+    OutputFormat format = OutputFormat::JSON;
+    CoordinatorOptions coordinator;
+    if (!parseOptions(argc, argv, 5, request.options, print_metrics, format, coordinator, option_error)) {
+        std::cerr << "ERROR: " << option_error << std::endl;
+        generateJSONOutput(json_output_path, false, option_error, request.algorithm, {}, 0);
+        return 1;
+    }
+
+    // 2. Carga del CSV y 3. Ejecución de la Búsqueda
+    // Cada sospechoso se escribe en cuanto termina su búsqueda, sin reunir antes todos los resultados.
+    std::ofstream output(json_output_path, format == OutputFormat::BINARY ? std::ios::binary : std::ios::out);
+    if (!output.is_open()) {
+        std::cerr << "ERROR: No se pudo crear el archivo de salida." << std::endl;
+        return 1;
+    }
+    std::unique_ptr<ResultWriter> writer = makeResultWriter(output, format, request.algorithm);
+    SearchOutcome outcome;
+    if (coordinator.workers > 0 || !coordinator.worker_sockets.empty()) {
+        // Modo coordinador: el CSV se reparte en fragmentos entre procesos dna_engine locales
+        // (--workers) o servidores (--worker-socket), y aquí solo se unen los resultados.
+        std::unique_ptr<ShardTransport> transport;
+        if (coordinator.worker_sockets.empty()) {
+            transport.reset(new ProcessTransport(argv[0]));
+        } else {
+            transport.reset(new SocketTransport(coordinator.worker_sockets));
+            if (coordinator.workers == 0) {
+                coordinator.workers = static_cast<unsigned>(coordinator.worker_sockets.size());
+            }
+        }
+        coordinator.progress = [](size_t done, size_t total, uint64_t done_bytes, uint64_t total_bytes) {
+            std::cout << "PROGRESS: " << done << "/" << total << " fragmentos (" << done_bytes << "/"
+                      << total_bytes << " bytes)" << std::endl;
+        };
+        outcome = runCoordinator(request, coordinator, *transport, writer.get());
+    } else {
+        outcome = runSearch(request, nullptr, writer.get());
+    }
+    if (!outcome.success) {
+        writer->finish(false, outcome.message, 0);
+        return 1;
+    }
+    
+    // 4. Cierre de la Salida y Reporte
+    writer->finish(true, outcome.message, outcome.duration_ms, &outcome.metrics);
+
+    std::cout << "SUCCESS: " << outcome.suspect_count << " coincidencias encontradas." << std::endl;
+    std::cout << "TIME_MS: " << outcome.duration_ms << std::endl;
+    if (print_metrics) {
+        writeMetricsSummary(std::cout, outcome.metrics);
+    }
+
+    return 0; 
+}
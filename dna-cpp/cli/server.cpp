@@ -0,0 +1,216 @@
+#include "server.hpp"
+#include "socket_io.hpp"
+#include "../src/search_service.hpp"
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+// Interpreta las líneas "clave=valor" de una petición.
+static bool parseRequest(const std::string& payload, SearchRequest& request, OutputFormat& format, std::string& error) {
+    std::istringstream lines(payload);
+    std::string line;
+    std::vector<std::string> pattern_lines;
+
+    while (std::getline(lines, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = "Línea de petición inválida: " + line;
+            return false;
+        }
+        const std::string key = line.substr(0, equals);
+        const std::string value = line.substr(equals + 1);
+
+        if (key == "csv") {
+            request.csv_path = value;
+        } else if (key == "algorithm") {
+            request.algorithm = value;
+        } else if (key == "pattern") {
+            pattern_lines.push_back(value);
+        } else if (key == "threads") {
+            size_t threads = 0;
+            if (!parseCount(value, threads)) {
+                error = "El valor de threads debe ser un entero no negativo.";
+                return false;
+            }
+            request.options.threads = static_cast<unsigned>(threads);
+        } else if (key == "max_errors") {
+            size_t max_errors = 0;
+            if (!parseCount(value, max_errors)) {
+                error = "El valor de max_errors debe ser un entero no negativo.";
+                return false;
+            }
+            request.options.max_errors = static_cast<int>(max_errors);
+        } else if (key == "both_strands") {
+            request.options.both_strands = value == "1" || value == "true";
+        } else if (key == "range") {
+            if (!parseByteRange(value, request.options)) {
+                error = "El valor de range debe ser B:E con B < E (bytes del CSV).";
+                return false;
+            }
+        } else if (key == "kmer_filter") {
+            request.options.kmer_filter = value == "1" || value == "true";
+        } else if (key == "result_cache") {
+            request.options.result_cache_dir = value;
+        } else if (key == "result_cache_limit") {
+            request.options.result_cache_limit = parseSize(value);
+            if (request.options.result_cache_limit == 0) {
+                error = "El valor de result_cache_limit debe ser un entero positivo (admite K, M o G).";
+                return false;
+            }
+        } else if (key == "query") {
+            if (!parseQuery(value, request.options.query)) {
+                error = "El valor de query debe ser all, exists, count, first=N o top=K.";
+                return false;
+            }
+        } else if (key == "format") {
+            if (!parseOutputFormat(value, format)) {
+                error = "El valor de format debe ser json, ndjson o binary.";
+                return false;
+            }
+        } else if (key == "stream") {
+            request.options.stream = value == "1" || value == "true";
+        } else if (key == "chunk_size") {
+            request.options.chunk_size = parseSize(value);
+            if (request.options.chunk_size == 0) {
+                error = "El valor de chunk_size debe ser un entero positivo (admite K, M o G).";
+                return false;
+            }
+        } else if (key == "pipeline_depth") {
+            if (!parseCount(value, request.options.pipeline_depth) || request.options.pipeline_depth == 0) {
+                error = "El valor de pipeline_depth debe ser un entero positivo.";
+                return false;
+            }
+        } else {
+            error = "Clave de petición no reconocida: " + key;
+            return false;
+        }
+    }
+
+    if (request.csv_path.empty() || request.algorithm.empty() || pattern_lines.empty()) {
+        error = "La petición debe incluir csv, algorithm y al menos un pattern.";
+        return false;
+    }
+
+    // Un único patrón sin marcador se trata igual que en la línea de comandos.
+    if (pattern_lines.size() == 1 && pattern_lines[0].find(',') == std::string::npos) {
+        request.pattern = pattern_lines[0];
+        return true;
+    }
+    for (const auto& pattern_line : pattern_lines) {
+        size_t comma = pattern_line.find(',');
+        if (comma == std::string::npos) {
+            request.panel.push_back({pattern_line, pattern_line});
+        } else {
+            request.panel.push_back({pattern_line.substr(0, comma), pattern_line.substr(comma + 1)});
+        }
+    }
+    return true;
+}
+
+static void handleClient(socket_t client, DatasetCache* cache) {
+    // Una excepción en el hilo de un cliente terminaría todo el servidor: se responde con el
+    // error y, si ni eso es posible, solo se cierra esa conexión.
+    try {
+        std::string payload;
+        while (readMessage(client, payload, MAX_REQUEST_BYTES)) {
+            SearchRequest request;
+            SearchOutcome outcome;
+            OutputFormat format = OutputFormat::JSON;
+            std::string error;
+            const bool parsed = parseRequest(payload, request, format, error);
+            const std::string algorithm = request.algorithm.empty() ? "None" : request.algorithm;
+
+            // Los sospechosos se escriben en la respuesta a medida que se encuentran.
+            std::ostringstream response;
+            std::unique_ptr<ResultWriter> writer = makeResultWriter(response, format, algorithm);
+            if (parsed) {
+                try {
+                    outcome = runSearch(request, cache, writer.get());
+                } catch (const std::exception& exception) {
+                    // Lo escrito hasta aquí quedó a medias: la respuesta es solo el error.
+                    response.str("");
+                    writer = makeResultWriter(response, format, algorithm);
+                    outcome = SearchOutcome();
+                    outcome.message = std::string("Error interno del servidor: ") + exception.what();
+                }
+            } else {
+                outcome.success = false;
+                outcome.message = error;
+            }
+            writer->finish(outcome.success, outcome.message, outcome.duration_ms,
+                           outcome.success ? &outcome.metrics : nullptr);
+            if (response.tellp() > static_cast<std::streamoff>(MAX_RESPONSE_BYTES)) {
+                // No cabe en un mensaje: se responde solo con el error.
+                response.str("");
+                writer = makeResultWriter(response, format, algorithm);
+                writer->finish(false,
+                               "La respuesta supera el máximo de " + std::to_string(MAX_RESPONSE_BYTES) +
+                                   " bytes; acote la búsqueda con query= o range=.",
+                               outcome.duration_ms, nullptr);
+            }
+            if (!writeMessage(client, response.str(), MAX_RESPONSE_BYTES)) {
+                break;
+            }
+        }
+    } catch (...) {
+        std::cerr << "ADVERTENCIA: Se cerró una conexión por un error inesperado." << std::endl;
+    }
+    closeSocket(client);
+}
+
+int runServer(const std::string& socket_path, size_t cache_capacity) {
+    // Un cliente que se desconecta a mitad de la respuesta no debe terminar el servidor.
+    if (!initSockets()) {
+        return 1;
+    }
+
+    sockaddr_un address;
+    if (!socketAddress(socket_path, address)) {
+        std::cerr << "ERROR: Ruta de socket vacía o demasiado larga: " << socket_path << std::endl;
+        return 1;
+    }
+
+    socket_t listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET_HANDLE) {
+        std::cerr << "ERROR: No se pudo crear el socket." << std::endl;
+        return 1;
+    }
+
+    // Un socket que quedó de una ejecución anterior impediría el bind. Solo se borra si es un
+    // socket: la ruta podría ser un archivo del usuario.
+    std::error_code status_error;
+    const std::filesystem::file_status status = std::filesystem::symlink_status(socket_path, status_error);
+    if (status.type() == std::filesystem::file_type::socket) {
+        std::remove(socket_path.c_str());
+    } else if (std::filesystem::exists(status)) {
+        std::cerr << "ERROR: La ruta ya existe y no es un socket: " << socket_path << std::endl;
+        closeSocket(listener);
+        return 1;
+    }
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        std::cerr << "ERROR: No se pudo escuchar en el socket: " << socket_path << std::endl;
+        closeSocket(listener);
+        return 1;
+    }
+
+    DatasetCache cache(cache_capacity);
+    std::cout << "LISTENING: " << socket_path << std::endl;
+
+    while (true) {
+        socket_t client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCKET_HANDLE) {
+            continue;
+        }
+        std::thread(handleClient, client, &cache).detach();
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <string>
+#include <cstddef>
+
+// Tamaño máximo aceptado para una petición (evita reservar memoria por un prefijo corrupto).
+const size_t MAX_REQUEST_BYTES = 16 * 1024 * 1024;
+
+// Tamaño máximo de una respuesta (el prefijo de longitud es de 32 bits). Una respuesta mayor
+// se reemplaza por un documento de error: conviene acotarla con query= o range=.
+const size_t MAX_RESPONSE_BYTES = size_t(1) << 31;
+
+// Modo servidor: escucha en un socket local (Unix domain socket) y atiende peticiones
+// de búsqueda sin crear un proceso por cada una.
+//
+// Cada mensaje (petición o respuesta) va precedido de su longitud en 4 bytes big-endian.
+// La petición es texto con una clave por línea:
+//   csv=<ruta del archivo>
+//   algorithm=KMP|RK|AC|BP|ED|HD
+//   pattern=<patrón> | pattern=@<archivo de panel> | pattern=<Marcador>,<patrón> (repetible: panel)
+//   threads=<N>                                    (opcional)
+//   max_errors=<K>                                 (opcional, solo ED y HD)
+//   range=<B>:<E>                                  (opcional, un fragmento del modo coordinador)
+// La respuesta es el mismo documento JSON que escribe el modo de línea de comandos.
+// Una conexión puede enviar varias peticiones seguidas; cada conexión se atiende en
+// su propio hilo y los CSV ya leídos se conservan en una caché LRU de 'cache_capacity' archivos.
+// Devuelve el código de salida del proceso.
+int runServer(const std::string& socket_path, size_t cache_capacity);
+
+#endif
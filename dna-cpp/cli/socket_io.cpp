@@ -0,0 +1,113 @@
+#include "socket_io.hpp"
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+bool initSockets() {
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        std::cerr << "ERROR: No se pudo inicializar Winsock." << std::endl;
+        return false;
+    }
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    return true;
+}
+
+void closeSocket(socket_t socket_handle) {
+#ifdef _WIN32
+    closesocket(socket_handle);
+#else
+    close(socket_handle);
+#endif
+}
+
+bool socketAddress(const std::string& socket_path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+    return true;
+}
+
+socket_t connectSocket(const std::string& socket_path) {
+    sockaddr_un address;
+    if (!socketAddress(socket_path, address)) {
+        return INVALID_SOCKET_HANDLE;
+    }
+    socket_t peer = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (peer == INVALID_SOCKET_HANDLE) {
+        return INVALID_SOCKET_HANDLE;
+    }
+    if (connect(peer, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        closeSocket(peer);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return peer;
+}
+
+// Lee exactamente 'length' bytes. Devuelve false si la conexión se cerró antes.
+// Bytes por llamada a send/recv, que reciben la longitud como int.
+const size_t MAX_IO_CHUNK = size_t(1) << 30;
+
+static bool readExact(socket_t peer, char* buffer, size_t length) {
+    while (length > 0) {
+        int received = recv(peer, buffer, static_cast<int>(std::min(length, MAX_IO_CHUNK)), 0);
+        if (received <= 0) {
+            return false;
+        }
+        buffer += received;
+        length -= received;
+    }
+    return true;
+}
+
+static bool writeExact(socket_t peer, const char* buffer, size_t length) {
+    while (length > 0) {
+        int sent = send(peer, buffer, static_cast<int>(std::min(length, MAX_IO_CHUNK)), 0);
+        if (sent <= 0) {
+            return false;
+        }
+        buffer += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+bool readMessage(socket_t peer, std::string& message, size_t max_bytes) {
+    unsigned char header[4];
+    if (!readExact(peer, reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    uint32_t length = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) |
+                      (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+    if (length > max_bytes) {
+        std::cerr << "ERROR: Mensaje demasiado grande (" << length << " bytes)." << std::endl;
+        return false;
+    }
+    message.resize(length);
+    return length == 0 || readExact(peer, &message[0], length);
+}
+
+bool writeMessage(socket_t peer, const std::string& message, size_t max_bytes) {
+    // Un prefijo truncado haría que el otro extremo leyera el resto como otro mensaje.
+    if (message.size() > max_bytes || message.size() > UINT32_MAX) {
+        std::cerr << "ERROR: Mensaje demasiado grande para enviar (" << message.size() << " bytes)." << std::endl;
+        return false;
+    }
+    const uint32_t length = static_cast<uint32_t>(message.size());
+    unsigned char header[4] = {
+        static_cast<unsigned char>(length >> 24), static_cast<unsigned char>(length >> 16),
+        static_cast<unsigned char>(length >> 8), static_cast<unsigned char>(length)};
+    return writeExact(peer, reinterpret_cast<const char*>(header), sizeof(header)) &&
+           writeExact(peer, message.data(), message.size());
+}
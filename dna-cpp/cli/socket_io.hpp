@@ -0,0 +1,43 @@
+#ifndef SOCKET_IO_HPP
+#define SOCKET_IO_HPP
+
+#include <string>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+using socket_t = SOCKET;
+const socket_t INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using socket_t = int;
+const socket_t INVALID_SOCKET_HANDLE = -1;
+#endif
+
+// Mensajes del modo servidor sobre un socket local (Unix domain socket): cada mensaje va
+// precedido de su longitud en 4 bytes big-endian.
+
+// Prepara los sockets del proceso (Winsock en Windows; en los demás sistemas, que un
+// extremo que se desconecta no termine el proceso con SIGPIPE). Retorna false si falla.
+bool initSockets();
+
+void closeSocket(socket_t socket_handle);
+
+// Llena la dirección del socket. Retorna false si la ruta está vacía o es demasiado larga.
+bool socketAddress(const std::string& socket_path, sockaddr_un& address);
+
+// Se conecta al socket de un servidor. Devuelve INVALID_SOCKET_HANDLE si no se pudo.
+socket_t connectSocket(const std::string& socket_path);
+
+// Lee un mensaje completo. Retorna false si la conexión se cerró o si el mensaje supera
+// 'max_bytes' (evita reservar memoria por un prefijo corrupto).
+bool readMessage(socket_t peer, std::string& message, size_t max_bytes);
+
+// Escribe un mensaje completo. Retorna false sin escribir nada si supera 'max_bytes' (o lo
+// que cabe en el prefijo de 32 bits), o si la conexión se cerró.
+bool writeMessage(socket_t peer, const std::string& message, size_t max_bytes);
+
+#endif
@@ -1,137 +1,197 @@
 #include "aho_corasick.hpp"
 #include <vector>
+#include <string_view>
 #include <queue>
-#include <map>
 #include <iostream>
 
 // --- Estructuras para el Autómata ---
 
-// Definimos el tamaño del alfabeto ADN (A, C, G, T)
-const int ALPHABET_SIZE = 4;
+// Tabla de traducción de caracteres ADN a índices (0-3); -1 para cualquier otro carácter.
+// Se evita así una cadena de comparaciones por cada base del texto.
+struct BaseIndexTable {
+    std::array<signed char, 256> index;
+
+    BaseIndexTable() {
+        index.fill(-1);
+        index['A'] = 0; index['a'] = 0;
+        index['C'] = 1; index['c'] = 1;
+        index['G'] = 2; index['g'] = 2;
+        index['T'] = 3; index['t'] = 3;
+    }
+};
+
+static const BaseIndexTable BASE_INDEX;
 
 // Mapea caracteres ADN a índices (0-3) para usar en vectores/arrays.
-int char_to_index(char c) {
-    if (c == 'A' || c == 'a') return 0;
-    if (c == 'C' || c == 'c') return 1;
-    if (c == 'G' || c == 'g') return 2;
-    if (c == 'T' || c == 't') return 3;
-    return -1; 
+static inline int char_to_index(char c) {
+    return BASE_INDEX.index[static_cast<unsigned char>(c)];
 }
 
-// Estructura de un nodo del Trie
-struct TrieNode {
-    std::map<int, int> transitions;
-    
-    int parent = -1; 
-    char parent_char = 0;
-    int failure_link = -1; 
-    bool is_end_of_pattern = false; 
-    
-    TrieNode() {
-        failure_link = 0;
+AhoCorasickAutomaton::AhoCorasickAutomaton(const std::vector<std::string>& patterns) {
+    std::array<int, ALPHABET_SIZE> empty;
+    empty.fill(-1);
+    goto_table.push_back(empty);
+    node_pattern.push_back(-1);
+
+    pattern_lengths.reserve(patterns.size());
+    next_same_pattern.assign(patterns.size(), -1);
+    for (size_t p = 0; p < patterns.size(); ++p) {
+        pattern_lengths.push_back(patterns[p].length());
+        insertPattern(patterns[p], p);
     }
-};
+    buildTransitions();
+}
+
+// 1. Inserción de un patrón en el Trie
+void AhoCorasickAutomaton::insertPattern(const std::string& pattern, int pattern_id) {
+    if (pattern.empty()) return;
 
-class AhoCorasickAutomaton {
-private:
-    std::vector<TrieNode> trie;
-    std::string pattern_to_search;
-    
-public:
-    AhoCorasickAutomaton(const std::string& pattern) : pattern_to_search(pattern) {
-        trie.push_back(TrieNode());
-        buildTrie();
-        buildFailureLinks();
+    // Un patrón con caracteres fuera del alfabeto nunca puede coincidir.
+    for (char c : pattern) {
+        if (char_to_index(c) == -1) return;
     }
 
-    // 1. Inserción de patrón en el Trie
-    void buildTrie() {
-        int current_node_index = 0;
-        for (char c : pattern_to_search) {
-            int index = char_to_index(c);
-            if (index == -1) continue; 
-
-            if (trie[current_node_index].transitions.find(index) == trie[current_node_index].transitions.end()) {
-                TrieNode new_node;
-                new_node.parent = current_node_index;
-                new_node.parent_char = c;
-                
-                trie[current_node_index].transitions[index] = trie.size();
-                trie.push_back(new_node);
-                current_node_index = trie.size() - 1;
-            } else {
-                current_node_index = trie[current_node_index].transitions[index];
-            }
+    int current_node_index = 0;
+    for (char c : pattern) {
+        int index = char_to_index(c);
+        if (goto_table[current_node_index][index] == -1) {
+            std::array<int, ALPHABET_SIZE> empty;
+            empty.fill(-1);
+            goto_table[current_node_index][index] = goto_table.size();
+            goto_table.push_back(empty);
+            node_pattern.push_back(-1);
         }
-        trie[current_node_index].is_end_of_pattern = true;
+        current_node_index = goto_table[current_node_index][index];
     }
 
-    // 2. Construcción de Enlaces de Fallo (BFS)
-    void buildFailureLinks() {
-        std::queue<int> q;
-        
-        for (const auto& pair : trie[0].transitions) {
-            int next_node = pair.second;
+    // Los patrones repetidos comparten estado final: se encadenan.
+    next_same_pattern[pattern_id] = node_pattern[current_node_index];
+    node_pattern[current_node_index] = pattern_id;
+}
+
+// 2. Enlaces de fallo (BFS) y cierre de la tabla de transiciones.
+// Cada transición ausente se reemplaza por la del estado de fallo, de modo que
+// la búsqueda nunca tiene que recorrer la cadena de fallos.
+void AhoCorasickAutomaton::buildTransitions() {
+    std::vector<int> failure_link(goto_table.size(), 0);
+    std::vector<bool> trie_edge(goto_table.size() * ALPHABET_SIZE, false);
+    output_link.assign(goto_table.size(), 0);
+    std::queue<int> q;
+
+    for (int c = 0; c < ALPHABET_SIZE; ++c) {
+        int next_node = goto_table[0][c];
+        trie_edge[c] = true; // en la raíz, quedarse tampoco es un fallo
+        if (next_node == -1) {
+            goto_table[0][c] = 0;
+        } else {
             q.push(next_node);
         }
+    }
 
-        while (!q.empty()) {
-            int r = q.front(); 
-            q.pop();
-
-            for (const auto& pair : trie[r].transitions) {
-                int index = pair.first;
-                int u = pair.second; 
-                q.push(u);
+    while (!q.empty()) {
+        int r = q.front();
+        q.pop();
 
-                int state = trie[r].failure_link;
+        for (int c = 0; c < ALPHABET_SIZE; ++c) {
+            int u = goto_table[r][c];
+            int fallback = goto_table[failure_link[r]][c];
 
-                while (trie[state].transitions.find(index) == trie[state].transitions.end() && state != 0) {
-                    state = trie[state].failure_link;
-                }
-                
-                if (trie[state].transitions.find(index) != trie[state].transitions.end()) {
-                    trie[u].failure_link = trie[state].transitions[index];
-                }
+            if (u == -1) {
+                goto_table[r][c] = fallback;
+                continue;
             }
+
+            trie_edge[r * ALPHABET_SIZE + c] = true;
+            failure_link[u] = fallback;
+            output_link[u] = node_pattern[fallback] != -1 ? fallback : output_link[fallback];
+            q.push(u);
         }
     }
 
-    // 3. Búsqueda en el texto (Scanning)
-    std::vector<int> search(const std::string& text) {
-        std::vector<int> matches;
-        int current_state = 0;
-        int pattern_len = pattern_to_search.length();
+    // Se marca en el bit bajo si cada transición avanza por el trie, para contar los fallos
+    // durante la búsqueda sin consultas adicionales a memoria.
+    for (size_t state = 0; state < goto_table.size(); ++state) {
+        for (int c = 0; c < ALPHABET_SIZE; ++c) {
+            goto_table[state][c] = (goto_table[state][c] << 1) | (trie_edge[state * ALPHABET_SIZE + c] ? 1 : 0);
+        }
+    }
+}
 
-        for (int i = 0; i < text.length(); ++i) {
-            char c = text[i];
-            int index = char_to_index(c);
-            if (index == -1) continue;
+// 3. Búsqueda en el texto (Scanning)
+std::vector<std::vector<int64_t>> AhoCorasickAutomaton::search(std::string_view text, SearchCounters* counters) const {
+    std::vector<std::vector<int64_t>> matches(pattern_lengths.size());
+    search(text, matches, counters);
+    return matches;
+}
 
-            while (trie[current_state].transitions.find(index) == trie[current_state].transitions.end() && current_state != 0) {
-                current_state = trie[current_state].failure_link;
-            }
-            
-            if (trie[current_state].transitions.find(index) != trie[current_state].transitions.end()) {
-                current_state = trie[current_state].transitions[index];
-            }
-            
-            int check_state = current_state;
-            while (check_state != 0) {
-                if (trie[check_state].is_end_of_pattern) {
-                    matches.push_back(i - pattern_len + 1);
-                }
-                check_state = trie[check_state].failure_link;
+template <typename Found>
+void AhoCorasickAutomaton::scan(std::string_view text, SearchCounters* counters, Found found) const {
+    int current_state = 0;
+    uint64_t failure_transitions = 0;
+    bool active = true;
+
+    for (size_t i = 0; i < text.length() && active; ++i) {
+        int index = char_to_index(text[i]);
+        if (index == -1) {
+            // Una base desconocida (p. ej. N) no puede formar parte de ninguna coincidencia.
+            current_state = 0;
+            continue;
+        }
+
+        int transition = goto_table[current_state][index];
+        current_state = transition >> 1;
+        failure_transitions += ~transition & 1;
+
+        int check_state = node_pattern[current_state] != -1 ? current_state : output_link[current_state];
+        while (check_state != 0 && active) {
+            for (int p = node_pattern[check_state]; p != -1 && active; p = next_same_pattern[p]) {
+                active = found(p, static_cast<int64_t>(i) - pattern_lengths[p] + 1);
             }
+            check_state = output_link[check_state];
         }
-        return matches;
     }
-};
+    if (counters) {
+        counters->ac_failure_transitions += failure_transitions;
+    }
+}
+
+void AhoCorasickAutomaton::search(std::string_view text, std::vector<std::vector<int64_t>>& matches,
+                                  SearchCounters* counters, size_t limit) const {
+    if (limit == SIZE_MAX) {
+        scan(text, counters, [&](int p, int64_t position) {
+            matches[p].push_back(position);
+            return true;
+        });
+        return;
+    }
+    if (limit == 0) {
+        return;
+    }
+    // Cada patrón deja de registrarse al llegar al límite, y el recorrido termina cuando
+    // todos llegaron.
+    std::vector<size_t> found(pattern_lengths.size(), 0);
+    size_t remaining = pattern_lengths.size();
+    scan(text, counters, [&](int p, int64_t position) {
+        if (found[p] == limit) {
+            return true;
+        }
+        matches[p].push_back(position);
+        return ++found[p] < limit || --remaining > 0;
+    });
+}
+
+void AhoCorasickAutomaton::count(std::string_view text, size_t end, std::vector<uint64_t>& counts,
+                                 SearchCounters* counters) const {
+    scan(text, counters, [&](int p, int64_t position) {
+        counts[p] += static_cast<size_t>(position) < end;
+        return true;
+    });
+}
 
-std::vector<int> AhoCorasickSearch(const std::string& text, const std::string& pattern) {
+std::vector<int64_t> AhoCorasickSearch(std::string_view text, const std::string& pattern) {
     if (pattern.empty()) {
         return {};
     }
-    AhoCorasickAutomaton automaton(pattern);
-    return automaton.search(text);
+    AhoCorasickAutomaton automaton({pattern});
+    return automaton.search(text)[0];
 }
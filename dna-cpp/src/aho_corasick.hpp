@@ -3,8 +3,67 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <string_view>
+#include <array>
+#include <cstdint>
+#include <cstddef>
 
-std::vector<int> AhoCorasickSearch(const std::string& text, const std::string& pattern);
+#include "metrics.hpp"
+
+// Definimos el tamaño del alfabeto ADN (A, C, G, T)
+const int ALPHABET_SIZE = 4;
+
+// Autómata Aho-Corasick multi-patrón sobre el alfabeto ADN.
+// Se construye una sola vez para todo el panel de patrones y luego se reutiliza
+// para cada secuencia: cada base del texto se procesa con una única consulta a la
+// tabla de transiciones, sin recorrer enlaces de fallo durante la búsqueda.
+class AhoCorasickAutomaton {
+public:
+    explicit AhoCorasickAutomaton(const std::vector<std::string>& patterns);
+
+    // Recorre el texto una sola vez. Devuelve, para cada patrón (en el mismo orden
+    // en que se entregaron), las posiciones iniciales de sus coincidencias (con solapamientos).
+    // Si se entrega 'counters', suma las transiciones que siguieron un enlace de fallo.
+    std::vector<std::vector<int64_t>> search(std::string_view text, SearchCounters* counters = nullptr) const;
+
+    // Igual que search, pero agrega las posiciones de cada patrón al final de matches[p], de
+    // modo que los mismos vectores se reutilizan entre secuencias. 'matches' debe tener al
+    // menos patternCount() elementos. Con 'limit', cada patrón deja de registrarse al agregar
+    // 'limit' posiciones y el recorrido termina cuando todos lo alcanzaron.
+    void search(std::string_view text, std::vector<std::vector<int64_t>>& matches,
+                SearchCounters* counters = nullptr, size_t limit = SIZE_MAX) const;
+
+    // Suma a counts[p] las coincidencias del patrón p que comienzan antes de 'end', sin
+    // guardar sus posiciones.
+    void count(std::string_view text, size_t end, std::vector<uint64_t>& counts,
+               SearchCounters* counters = nullptr) const;
+
+    size_t patternCount() const { return pattern_lengths.size(); }
+    size_t stateCount() const { return goto_table.size(); }
+
+private:
+    // goto_table[estado][base]: transición completa (goto + fallo precalculados). Tras la
+    // construcción cada entrada vale (siguiente_estado << 1) | 1 si avanza por el trie o se
+    // queda en la raíz, y (siguiente_estado << 1) si sigue un enlace de fallo.
+    std::vector<std::array<int, ALPHABET_SIZE>> goto_table;
+    // Enlace de salida: siguiente estado terminal en la cadena de fallos (0 si no hay).
+    std::vector<int> output_link;
+    // Primer patrón que termina en cada estado (-1 si el estado no es terminal).
+    std::vector<int> node_pattern;
+    // Siguiente patrón idéntico que termina en el mismo estado (patrones duplicados).
+    std::vector<int> next_same_pattern;
+    std::vector<int> pattern_lengths;
+
+    void insertPattern(const std::string& pattern, int pattern_id);
+    void buildTransitions();
+
+    // Recorre el texto y llama a found(patrón, posición) en cada coincidencia; el recorrido
+    // termina en cuanto found retorna false.
+    template <typename Found>
+    void scan(std::string_view text, SearchCounters* counters, Found found) const;
+};
+
+// Búsqueda de un único patrón (compatibilidad con el modo de un solo patrón).
+std::vector<int64_t> AhoCorasickSearch(std::string_view text, const std::string& pattern);
 
 #endif
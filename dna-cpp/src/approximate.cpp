@@ -0,0 +1,170 @@
+#include "approximate.hpp"
+#include <cmath>
+
+ApproximateMatcher::ApproximateMatcher(const std::string& pattern, int max_errors, bool substitutions_only)
+    : packed_pattern(packSequence(pattern)), pattern_length(pattern.length()), max_errors(max_errors),
+      substitutions_only(substitutions_only),
+      searchable(!pattern.empty() && !packed_pattern.hasAmbiguous() && max_errors >= 0) {
+
+    if (substitutions_only) {
+        return;
+    }
+    // Myers: bit r del bloque b en 1 si la fila 64*b + r del patrón coincide con la base.
+    peq_blocks.resize((pattern_length + 63) / 64);
+    for (auto& block : peq_blocks) {
+        block.fill(0);
+    }
+    for (size_t r = 0; r < pattern_length; ++r) {
+        int code = packed_pattern.codeAt(r);
+        if (code != AMBIGUOUS_CODE) {
+            peq_blocks[r / 64][code] |= uint64_t(1) << (r % 64);
+        }
+    }
+}
+
+void ApproximateMatcher::search(const PackedSequence& text, size_t begin, size_t end,
+                                std::vector<int64_t>& positions, std::vector<int>& distances) const {
+    if (end > text.length) {
+        end = text.length;
+    }
+    if (!searchable || begin >= end) {
+        return;
+    }
+    if (substitutions_only) {
+        searchHamming(text, begin, end, positions, distances);
+    } else {
+        searchEditDistance(text, begin, end, positions, distances);
+    }
+}
+
+// Avanza un bloque de 64 filas de la matriz de Myers con la diferencia horizontal que
+// llega del bloque superior (hin) y devuelve la que sale por su última fila.
+static inline int advanceBlock(uint64_t& pv, uint64_t& mv, uint64_t eq, int hin, uint64_t high_bit) {
+    uint64_t xv = eq | mv;
+    if (hin < 0) {
+        eq |= 1;
+    }
+    uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+
+    int hout = 0;
+    if (ph & high_bit) {
+        hout = 1;
+    } else if (mh & high_bit) {
+        hout = -1;
+    }
+
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) {
+        mh |= 1;
+    } else if (hin > 0) {
+        ph |= 1;
+    }
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    return hout;
+}
+
+void ApproximateMatcher::searchEditDistance(const PackedSequence& text, size_t begin, size_t end,
+                                            std::vector<int64_t>& positions, std::vector<int>& distances) const {
+    const size_t blocks = peq_blocks.size();
+    const uint64_t last_high_bit = uint64_t(1) << ((pattern_length - 1) % 64);
+    std::vector<uint64_t> pv(blocks, ~uint64_t(0));
+    std::vector<uint64_t> mv(blocks, 0);
+    long long score = pattern_length;
+    const size_t first_match = positions.size(); // puede haber coincidencias de otras búsquedas antes
+
+    // Una alineación con a lo sumo k errores mide como máximo m + k bases: basta con
+    // empezar k bases antes de 'begin' para obtener las mismas distancias que con la secuencia completa.
+    size_t scan_begin = begin > static_cast<size_t>(max_errors) ? begin - max_errors : 0;
+    size_t scan_end = end + pattern_length - 1;
+    if (scan_end > text.length) {
+        scan_end = text.length;
+    }
+
+    for (size_t j = scan_begin; j < scan_end; ++j) {
+        int code = text.codeAt(j);
+        int carry = 0;
+        for (size_t b = 0; b < blocks; ++b) {
+            carry = advanceBlock(pv[b], mv[b], peq_blocks[b][code], carry,
+                                 b + 1 == blocks ? last_high_bit : uint64_t(1) << 63);
+        }
+        score += carry;
+
+        if (score > max_errors) continue;
+
+        long long position = static_cast<long long>(j) + 1 - static_cast<long long>(pattern_length);
+        if (position < static_cast<long long>(begin)) {
+            // Alineaciones que empiezan antes de la secuencia (borrados al inicio) se asignan a la posición 0.
+            if (begin != 0) continue;
+            position = 0;
+        }
+        if (positions.size() > first_match && positions.back() == position) {
+            if (score < distances.back()) {
+                distances.back() = score;
+            }
+            continue;
+        }
+        positions.push_back(position);
+        distances.push_back(score);
+    }
+}
+
+// Distribuye los 32 bits de x en los bits pares de una palabra de 64 bits (bit k -> bit 2k).
+static inline uint64_t spreadBits(uint32_t x) {
+    uint64_t v = x;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v << 2)) & 0x3333333333333333ULL;
+    v = (v | (v << 1)) & 0x5555555555555555ULL;
+    return v;
+}
+
+void ApproximateMatcher::searchHamming(const PackedSequence& text, size_t begin, size_t end,
+                                       std::vector<int64_t>& positions, std::vector<int>& distances) const {
+    if (text.length < pattern_length) {
+        return;
+    }
+    size_t last_start = text.length - pattern_length + 1;
+    if (end > last_start) {
+        end = last_start;
+    }
+    const size_t words = packed_pattern.bases.size();
+    const size_t tail = pattern_length - (words - 1) * 32;
+    const uint64_t tail_mask = tail == 32 ? ~uint64_t(0) : (uint64_t(1) << (2 * tail)) - 1;
+    const bool has_ambiguous = text.hasAmbiguous();
+
+    for (size_t i = begin; i < end; ++i) {
+        int errors = 0;
+        for (size_t w = 0; w < words && errors <= max_errors; ++w) {
+            uint64_t x = text.extractWord(i + w * 32) ^ packed_pattern.bases[w];
+            // Una base difiere si cualquiera de sus dos bits difiere.
+            uint64_t diff = (x | (x >> 1)) & 0x5555555555555555ULL;
+            if (has_ambiguous) {
+                diff |= spreadBits(text.extractAmbiguous(i + w * 32));
+            }
+            if (w + 1 == words) {
+                diff &= tail_mask;
+            }
+            errors += __builtin_popcountll(diff);
+        }
+        if (errors <= max_errors) {
+            positions.push_back(i);
+            distances.push_back(errors);
+        }
+    }
+}
+
+double similarityPercent(int distance, size_t pattern_length) {
+    if (pattern_length == 0) {
+        return 0.0;
+    }
+    double similarity = 100.0 * (static_cast<double>(pattern_length) - distance) / pattern_length;
+    if (similarity < 0.0) {
+        similarity = 0.0;
+    }
+    return std::round(similarity * 100.0) / 100.0;
+}
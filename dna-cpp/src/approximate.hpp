@@ -0,0 +1,46 @@
+#ifndef APPROXIMATE_HPP
+#define APPROXIMATE_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+#include "packed_dna.hpp"
+
+// Búsqueda aproximada sobre secuencias empaquetadas, con un máximo de 'max_errors' errores.
+// - Distancia de edición (sustituciones, inserciones y borrados): algoritmo bit-vector de
+//   Myers, O(n * ceil(m / 64)) en lugar de la programación dinámica O(n * m).
+// - Distancia de Hamming (solo sustituciones): se comparan 32 bases por operación XOR
+//   sobre las palabras empaquetadas y se cuentan las diferencias con popcount.
+// Para la distancia de edición la posición reportada es fin_de_alineación - m + 1
+// (limitada a 0), ya que el inicio de una alineación con inserciones no es único.
+class ApproximateMatcher {
+public:
+    ApproximateMatcher(const std::string& pattern, int max_errors, bool substitutions_only);
+
+    // Agrega a 'positions' y 'distances' las coincidencias cuya posición está en [begin, end),
+    // en orden creciente. Lee las bases necesarias antes de begin y después de end para que
+    // el resultado no dependa de cómo se divida la secuencia.
+    void search(const PackedSequence& text, size_t begin, size_t end,
+                std::vector<int64_t>& positions, std::vector<int>& distances) const;
+
+private:
+    PackedSequence packed_pattern;
+    size_t pattern_length;
+    int max_errors;
+    bool substitutions_only;
+    bool searchable; // false si el patrón está vacío o contiene bases fuera del alfabeto
+    // Myers: una máscara de 64 filas del patrón por bloque y por código de base.
+    std::vector<std::array<uint64_t, AMBIGUOUS_CODE + 1>> peq_blocks;
+
+    void searchEditDistance(const PackedSequence& text, size_t begin, size_t end,
+                            std::vector<int64_t>& positions, std::vector<int>& distances) const;
+    void searchHamming(const PackedSequence& text, size_t begin, size_t end,
+                       std::vector<int64_t>& positions, std::vector<int>& distances) const;
+};
+
+// Similitud en porcentaje (0-100) correspondiente a una distancia sobre un patrón de longitud m.
+double similarityPercent(int distance, size_t pattern_length);
+
+#endif
@@ -0,0 +1,116 @@
+#include "bit_parallel.hpp"
+
+BitParallelMatcher::BitParallelMatcher(const std::string& pattern)
+    : packed_pattern(packSequence(pattern)), pattern_length(pattern.length()),
+      searchable(!pattern.empty() && !packed_pattern.hasAmbiguous()) {
+
+    if (!usesBNDM()) {
+        // Shift-Or: bit j en 0 si pattern[j] coincide con la base (0 = coincidencia).
+        masks.fill(~uint64_t(0));
+        for (size_t j = 0; j < pattern_length; ++j) {
+            masks[packed_pattern.codeAt(j)] &= ~(uint64_t(1) << j);
+        }
+    } else {
+        // BNDM: bit (L-1-j) en 1 si pattern[j] coincide con la base, sobre las primeras L bases.
+        masks.fill(0);
+        for (size_t j = 0; j < BIT_PARALLEL_WORD; ++j) {
+            masks[packed_pattern.codeAt(j)] |= uint64_t(1) << (BIT_PARALLEL_WORD - 1 - j);
+        }
+    }
+    // Una base ambigua nunca coincide.
+    masks[AMBIGUOUS_CODE] = usesBNDM() ? 0 : ~uint64_t(0);
+}
+
+std::vector<int64_t> BitParallelMatcher::search(const PackedSequence& text) const {
+    return search(text, 0, text.length);
+}
+
+std::vector<int64_t> BitParallelMatcher::search(const PackedSequence& text, size_t begin, size_t end) const {
+    std::vector<int64_t> matches;
+    search(text, begin, end, matches);
+    return matches;
+}
+
+void BitParallelMatcher::search(const PackedSequence& text, size_t begin, size_t end,
+                                std::vector<int64_t>& matches) const {
+    if (end > text.length) {
+        end = text.length;
+    }
+    if (!searchable || begin >= end || end - begin < pattern_length) {
+        return;
+    }
+    if (usesBNDM()) {
+        bndm(text, begin, end, matches);
+    } else {
+        shiftOr(text, begin, end, matches);
+    }
+}
+
+// Shift-Or: se consume una palabra de 32 bases por iteración externa, sin decodificar caracteres.
+void BitParallelMatcher::shiftOr(const PackedSequence& text, size_t begin, size_t end,
+                                 std::vector<int64_t>& matches) const {
+    const uint64_t high_bit = uint64_t(1) << (pattern_length - 1);
+    uint64_t state = ~uint64_t(0);
+
+    for (size_t base_pos = begin; base_pos < end; base_pos += 32) {
+        uint64_t chunk = text.extractWord(base_pos);
+        uint64_t ambiguous = text.extractAmbiguous(base_pos);
+        size_t count = end - base_pos < 32 ? end - base_pos : 32;
+
+        for (size_t k = 0; k < count; ++k) {
+            state = (state << 1) | masks[chunk & 3] | (uint64_t(0) - ((ambiguous >> k) & 1));
+            chunk >>= 2;
+            if (!(state & high_bit)) {
+                matches.push_back(base_pos + k + 1 - pattern_length);
+            }
+        }
+    }
+}
+
+// BNDM: lee la ventana de derecha a izquierda y salta según el prefijo más largo reconocido.
+void BitParallelMatcher::bndm(const PackedSequence& text, size_t begin, size_t end,
+                              std::vector<int64_t>& matches) const {
+    const size_t window = BIT_PARALLEL_WORD;
+    const uint64_t high_bit = uint64_t(1) << (window - 1);
+    size_t pos = begin;
+
+    while (pos + pattern_length <= end) {
+        size_t j = window;
+        size_t last = window;
+        uint64_t state = ~uint64_t(0);
+
+        while (state != 0 && j > 0) {
+            state &= masks[text.codeAt(pos + j - 1)];
+            --j;
+            if (state & high_bit) {
+                if (j > 0) {
+                    last = j;
+                } else if (verify(text, pos)) {
+                    matches.push_back(pos);
+                }
+            }
+            state <<= 1;
+        }
+        pos += last;
+    }
+}
+
+// Verificación del patrón completo comparando 32 bases por palabra.
+bool BitParallelMatcher::verify(const PackedSequence& text, size_t pos) const {
+    for (size_t k = 0; k < packed_pattern.bases.size(); ++k) {
+        uint64_t text_word = text.extractWord(pos + k * 32);
+        size_t remaining = pattern_length - k * 32;
+        if (remaining < 32) {
+            text_word &= (uint64_t(1) << (2 * remaining)) - 1;
+        }
+        if (text_word != packed_pattern.bases[k]) {
+            return false;
+        }
+    }
+    return !text.hasAmbiguousIn(pos, pattern_length);
+}
+
+std::vector<int64_t> BitParallelSearch(const PackedSequence& text, const std::string& pattern) {
+    BitParallelMatcher matcher(pattern);
+    return matcher.search(text);
+}
@@ -0,0 +1,50 @@
+#ifndef BIT_PARALLEL_HPP
+#define BIT_PARALLEL_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+#include "packed_dna.hpp"
+
+// Longitud máxima de patrón que cabe en el vector de estado (una palabra de 64 bits).
+const size_t BIT_PARALLEL_WORD = 64;
+
+// Búsqueda bit-paralela sobre secuencias empaquetadas a 2 bits por base.
+// - Patrones de hasta 64 bases: Shift-Or, el estado completo del autómata cabe en una palabra.
+// - Patrones más largos: BNDM sobre las primeras 64 bases del patrón, con verificación
+//   del patrón completo comparando 32 bases por palabra.
+// Las máscaras se calculan una sola vez y el buscador se reutiliza para cada sospechoso.
+class BitParallelMatcher {
+public:
+    explicit BitParallelMatcher(const std::string& pattern);
+
+    // Devuelve las posiciones iniciales de las coincidencias (incluyendo solapamientos).
+    std::vector<int64_t> search(const PackedSequence& text) const;
+
+    // Igual que search, pero solo lee las bases del rango [begin, end) del texto.
+    // Las posiciones devueltas son absolutas dentro de la secuencia.
+    std::vector<int64_t> search(const PackedSequence& text, size_t begin, size_t end) const;
+
+    // Igual que la anterior, pero agrega las posiciones al final de 'matches'.
+    void search(const PackedSequence& text, size_t begin, size_t end, std::vector<int64_t>& matches) const;
+
+    bool usesBNDM() const { return pattern_length > BIT_PARALLEL_WORD; }
+
+private:
+    PackedSequence packed_pattern;
+    size_t pattern_length;
+    bool searchable; // false si el patrón está vacío o contiene bases fuera del alfabeto
+    // Una máscara por código de base (A, C, G, T y ambiguo).
+    std::array<uint64_t, AMBIGUOUS_CODE + 1> masks;
+
+    void shiftOr(const PackedSequence& text, size_t begin, size_t end, std::vector<int64_t>& matches) const;
+    void bndm(const PackedSequence& text, size_t begin, size_t end, std::vector<int64_t>& matches) const;
+    bool verify(const PackedSequence& text, size_t pos) const;
+};
+
+// Búsqueda de un único patrón sobre una secuencia empaquetada.
+std::vector<int64_t> BitParallelSearch(const PackedSequence& text, const std::string& pattern);
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+// Cola acotada sin bloqueos para varios productores y varios consumidores (el esquema de
+// celdas numeradas de D. Vyukov): cada celda lleva un número de secuencia que indica si está
+// libre para el productor de esa vuelta o lista para el consumidor, y productores y
+// consumidores solo compiten por su propio índice con una comparación e intercambio.
+// La capacidad se redondea a una potencia de dos. T debe copiarse sin fallar (p. ej. un puntero).
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        cells.reset(new Cell[rounded]);
+        mask = rounded - 1;
+        for (size_t i = 0; i < rounded; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Retorna false si la cola está llena.
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Retorna false si la cola está vacía.
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Elementos en la cola en este momento (aproximado si otros hilos la están usando).
+    size_t size() const {
+        const size_t pushed = tail.load(std::memory_order_relaxed);
+        const size_t popped = head.load(std::memory_order_relaxed);
+        return pushed > popped ? pushed - popped : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    // En líneas de caché distintas, para que productores y consumidores no se estorben.
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> head{0};
+};
+
+// Espera de un hilo a que otro libere o llene una cola: unas vueltas activas (la espera suele
+// ser corta si las etapas están equilibradas), luego cede el procesador y, si la espera se
+// alarga, duerme de a poco para no ocupar un núcleo.
+class Backoff {
+public:
+    void pause() {
+        if (++rounds <= 64) {
+            return;
+        }
+        if (rounds <= 256) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+private:
+    unsigned rounds = 0;
+};
+
+#endif
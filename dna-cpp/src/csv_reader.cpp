@@ -1,38 +1,83 @@
 #include "csv_reader.hpp"
+#include "mapped_csv.hpp"
 #include <fstream>
-#include <sstream>
 #include <iostream>
 
 bool readCSV(const std::string& filename, SuspectList& out_suspects) {
+    // Compatibilidad: se copian las vistas del archivo mapeado a cadenas propias.
+    MappedSuspectList mapped;
+    if (!loadMappedCSV(filename, mapped)) {
+        return false;
+    }
+    out_suspects.reserve(out_suspects.size() + mapped.records.size());
+    for (const auto& record : mapped.records) {
+        out_suspects.push_back({std::string(record.name), std::string(record.sequence)});
+    }
+    return true;
+}
+
+bool readPackedCSV(const std::string& filename, PackedSuspectList& out_suspects) {
+    MappedSuspectList mapped;
+    if (!loadMappedCSV(filename, mapped)) {
+        return false;
+    }
+    packSuspects(mapped.records, out_suspects);
+    return true;
+}
+
+void packSuspects(const std::vector<SuspectView>& records, PackedSuspectList& out_suspects) {
+    out_suspects.reserve(out_suspects.size() + records.size());
+    for (const auto& record : records) {
+        out_suspects.push_back({std::string(record.name), packSequence(record.sequence)});
+    }
+}
+
+// Elimina espacios y saltos de línea (incluido '\r' de archivos Windows) en los extremos.
+static std::string trim(const std::string& value) {
+    const char* whitespace = " \t\r\n";
+    size_t start = value.find_first_not_of(whitespace);
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = value.find_last_not_of(whitespace);
+    return value.substr(start, end - start + 1);
+}
+
+bool readPatternPanel(const std::string& filename, PatternList& out_patterns) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "ERROR: No se pudo abrir el archivo CSV en la ruta: " << filename << std::endl;
+        std::cerr << "ERROR: No se pudo abrir el archivo de patrones en la ruta: " << filename << std::endl;
         return false;
     }
 
     std::string line;
-    // Omitir la línea de cabecera (Nombre,Cadena_ADN)
-    if (std::getline(file, line)) {
-        // Validación básica de la cabecera si es necesario.
-    }
-
-    // Leer el resto de las líneas
     while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string name;
-        std::string dna_sequence;
-        
-        // Asume que las columnas están separadas por coma.
-        if (std::getline(ss, name, ',') && std::getline(ss, dna_sequence, ',')) {
-            // Los datos se asumen limpios, pero aquí iría la validación de formato (A, C, G, T)
-            // y que sean exactamente 2 columnas.
-            out_suspects.push_back({name, dna_sequence});
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::string marker;
+        std::string pattern;
+        size_t comma = line.find(',');
+        if (comma == std::string::npos) {
+            pattern = line;
+            marker = line;
+        } else {
+            marker = trim(line.substr(0, comma));
+            pattern = trim(line.substr(comma + 1));
         }
+
+        if (pattern.empty()) {
+            std::cerr << "ADVERTENCIA: Marcador sin patrón omitido: " << marker << std::endl;
+            continue;
+        }
+        out_patterns.push_back({marker, pattern});
     }
 
-    if (out_suspects.empty()) {
-        // Podría ser un archivo vacío o mal formateado (solo cabecera).
-        std::cerr << "ADVERTENCIA: No se encontraron registros válidos en el archivo CSV." << std::endl;
+    if (out_patterns.empty()) {
+        std::cerr << "ERROR: El archivo de patrones no contiene patrones válidos." << std::endl;
+        return false;
     }
 
     return true;
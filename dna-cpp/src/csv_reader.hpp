@@ -5,6 +5,9 @@
 #include <vector>
 #include <utility> 
 
+#include "packed_dna.hpp"
+#include "mapped_csv.hpp"
+
 // Define la estructura para un sospechoso: Nombre y Cadena de ADN
 using SuspectData = std::pair<std::string, std::string>;
 
@@ -13,6 +16,33 @@ using SuspectList = std::vector<SuspectData>;
 
 // Lee un archivo CSV con formato (Nombre,Cadena_ADN) y devuelve una lista de SuspectData.
 // Retorna true en caso de éxito, false en caso de fallo (ej. archivo no encontrado).
+// Se conserva por compatibilidad: copia cada registro. Para evitar copias usar loadMappedCSV.
 bool readCSV(const std::string& filename, SuspectList& out_suspects);
 
+// Sospechoso con la secuencia empaquetada a 2 bits por base
+struct PackedSuspect {
+    std::string name;
+    PackedSequence sequence;
+};
+
+using PackedSuspectList = std::vector<PackedSuspect>;
+
+// Igual que readCSV, pero empaqueta cada secuencia directamente desde el archivo mapeado,
+// sin crear cadenas intermedias, de modo que la memoria se reduce ~4x.
+bool readPackedCSV(const std::string& filename, PackedSuspectList& out_suspects);
+
+// Empaqueta registros ya separados (por ejemplo, de un CSV recibido en memoria).
+void packSuspects(const std::vector<SuspectView>& records, PackedSuspectList& out_suspects);
+
+// Define un marcador del panel: Nombre del marcador y Patrón ADN
+using PatternEntry = std::pair<std::string, std::string>;
+
+// Define el tipo para un panel completo de marcadores
+using PatternList = std::vector<PatternEntry>;
+
+// Lee un archivo de panel con un patrón por línea, en formato "Patron" o "Marcador,Patron".
+// Se ignoran las líneas vacías y las que comienzan con '#'.
+// Retorna true en caso de éxito, false si el archivo no existe o no contiene patrones.
+bool readPatternPanel(const std::string& filename, PatternList& out_patterns);
+
 #endif
@@ -0,0 +1,99 @@
+#include "dataset_cache.hpp"
+
+std::shared_ptr<const Dataset> loadDataset(const std::string& path, DatasetFormat format, bool with_kmer_filter) {
+    std::shared_ptr<Dataset> dataset = std::make_shared<Dataset>();
+    bool loaded = false;
+    switch (format) {
+    case DatasetFormat::Text:
+        loaded = loadMappedCSV(path, dataset->suspects);
+        break;
+    case DatasetFormat::Packed:
+        loaded = readPackedCSV(path, dataset->packed_suspects);
+        break;
+    case DatasetFormat::Index:
+        loaded = loadOrBuildFMIndex(path, dataset->fm_index);
+        break;
+    }
+    if (!loaded || (with_kmer_filter && !loadOrBuildKmerFilter(path, dataset->kmer_filter))) {
+        return nullptr;
+    }
+    return dataset;
+}
+
+std::shared_ptr<const Dataset> loadDatasetFromMemory(std::string_view content, DatasetFormat format,
+                                                     bool with_kmer_filter) {
+    std::shared_ptr<Dataset> dataset = std::make_shared<Dataset>();
+    if (!parseCSVBuffer(content, dataset->suspects)) {
+        return nullptr;
+    }
+    if (format == DatasetFormat::Packed) {
+        packSuspects(dataset->suspects.records, dataset->packed_suspects);
+    } else if (format == DatasetFormat::Index) {
+        if (!dataset->fm_index.build(dataset->suspects.records, content.size(), 0)) {
+            return nullptr;
+        }
+    }
+    if (with_kmer_filter && !dataset->kmer_filter.build(dataset->suspects.records, content.size(), 0)) {
+        return nullptr;
+    }
+    return dataset;
+}
+
+std::shared_ptr<const Dataset> loadDatasetRange(const std::string& path, uint64_t begin, uint64_t end,
+                                                DatasetFormat format) {
+    std::shared_ptr<Dataset> dataset = std::make_shared<Dataset>();
+    if (format == DatasetFormat::Index || !loadMappedCSVRange(path, begin, end, dataset->suspects)) {
+        return nullptr;
+    }
+    if (format == DatasetFormat::Packed) {
+        packSuspects(dataset->suspects.records, dataset->packed_suspects);
+    }
+    return dataset;
+}
+
+DatasetCache::DatasetCache(size_t capacity) : capacity(capacity) {}
+
+std::shared_ptr<const Dataset> DatasetCache::get(const std::string& path, DatasetFormat format, bool with_kmer_filter) {
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, error);
+    uintmax_t size = error ? 0 : std::filesystem::file_size(path, error);
+    if (error) {
+        // El archivo no existe o no es accesible: loadDataset informará el error.
+        return loadDataset(path, format, with_kmer_filter);
+    }
+
+    static const char* const KEY_PREFIX[] = {"txt:", "2b:", "fm:"};
+    const std::string key = KEY_PREFIX[static_cast<int>(format)] + std::string(with_kmer_filter ? "kmf:" : "") + path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->key != key) continue;
+            if (it->modified == modified && it->size == size) {
+                entries.splice(entries.begin(), entries, it);
+                return it->data;
+            }
+            // El archivo cambió desde que se cargó: se descarta la copia.
+            entries.erase(it);
+            break;
+        }
+    }
+
+    // La lectura se hace fuera del candado para no bloquear a las demás peticiones.
+    std::shared_ptr<const Dataset> dataset = loadDataset(path, format, with_kmer_filter);
+    if (!dataset || capacity == 0) {
+        return dataset;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->key == key) {
+            entries.erase(it);
+            break;
+        }
+    }
+    entries.push_front({key, modified, size, dataset});
+    while (entries.size() > capacity) {
+        entries.pop_back();
+    }
+    return dataset;
+}
@@ -0,0 +1,70 @@
+#ifndef DATASET_CACHE_HPP
+#define DATASET_CACHE_HPP
+
+#include <string>
+#include <string_view>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <filesystem>
+
+#include "csv_reader.hpp"
+#include "mapped_csv.hpp"
+#include "fm_index.hpp"
+#include "kmer_filter.hpp"
+
+// Representación de los sospechosos que necesita cada algoritmo.
+enum class DatasetFormat {
+    Text,   // texto mapeado sin copias (KMP, RK, AC, SIMD)
+    Packed, // empaquetado a 2 bits por base (BP, ED, HD)
+    Index   // índice FM guardado junto al CSV (FM)
+};
+
+// Sospechosos de un CSV cargados en memoria, en la representación que usa el algoritmo.
+struct Dataset {
+    MappedSuspectList suspects;
+    PackedSuspectList packed_suspects;
+    FMIndex fm_index;
+    KmerFilter kmer_filter; // solo si se pidió al cargar (vacío: suspectCount() == 0)
+};
+
+// Lee el CSV completo (o su índice). Con 'with_kmer_filter' abre también el prefiltro de
+// k-mers guardado junto al CSV, o lo construye y lo guarda. Devuelve nullptr si el archivo
+// no se pudo leer.
+std::shared_ptr<const Dataset> loadDataset(const std::string& path, DatasetFormat format, bool with_kmer_filter = false);
+
+// Igual que loadDataset, pero a partir del contenido del CSV ya en memoria. Las vistas del
+// dataset apuntan a 'content', que debe seguir vivo mientras se use. En FM el índice (y el
+// prefiltro) se construyen en memoria y no se guardan.
+std::shared_ptr<const Dataset> loadDatasetFromMemory(std::string_view content, DatasetFormat format,
+                                                     bool with_kmer_filter = false);
+
+// Igual que loadDataset, pero solo con los registros del rango de bytes [begin, end) del CSV
+// (un fragmento del modo coordinador). No admite FM, cuyo índice abarca el CSV completo.
+std::shared_ptr<const Dataset> loadDatasetRange(const std::string& path, uint64_t begin, uint64_t end,
+                                                DatasetFormat format);
+
+// Caché LRU de datasets ya cargados, compartida entre las peticiones del modo servidor.
+// Cada entrada recuerda la fecha de modificación y el tamaño del archivo: si cambian,
+// el dataset se vuelve a leer. Las peticiones en curso conservan su copia (shared_ptr)
+// aunque la entrada sea desalojada.
+class DatasetCache {
+public:
+    explicit DatasetCache(size_t capacity);
+
+    std::shared_ptr<const Dataset> get(const std::string& path, DatasetFormat format, bool with_kmer_filter = false);
+
+private:
+    struct Entry {
+        std::string key;
+        std::filesystem::file_time_type modified;
+        uintmax_t size;
+        std::shared_ptr<const Dataset> data;
+    };
+
+    size_t capacity;
+    std::list<Entry> entries; // la más reciente al frente
+    std::mutex mutex;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef DNA_ENGINE_H
+#define DNA_ENGINE_H
+
+/*
+ * API en C de la biblioteca de búsqueda (libdna_engine). Permite usar el motor desde
+ * otros lenguajes sin pasar por el ejecutable ni por archivos JSON. Desde C++ también
+ * se puede usar directamente runSearch (search_service.hpp).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Parámetros de una búsqueda. Se indica csv_path, o bien csv_data/csv_size con el
+ * contenido del CSV ya en memoria (que debe seguir vivo durante la llamada). */
+typedef struct dna_search_params {
+    const char* csv_path;
+    const char* csv_data;
+    size_t csv_size;
+    const char* algorithm;        /* KMP, RK, AC, BP, ED, HD, FM o SIMD */
+    const char* const* patterns;
+    const char* const* markers;   /* opcional: nombre de cada marcador (NULL = modo de un solo patrón) */
+    size_t pattern_count;
+    unsigned threads;             /* 0 = todos los núcleos */
+    int max_errors;               /* solo ED y HD */
+    int both_strands;             /* distinto de 0: buscar también el complemento reverso */
+    const char* result_cache_dir; /* opcional: carpeta de la caché de resultados (NULL = sin caché) */
+    uint64_t result_cache_limit;  /* tamaño máximo de la caché en bytes (0 = por defecto) */
+    const char* query;            /* opcional: "exists", "count", "first=N" o "top=K" (NULL = todas las posiciones) */
+    int kmer_filter;              /* distinto de 0: usar el prefiltro de k-mers (se guarda junto al CSV) */
+} dna_search_params;
+
+/* Coincidencias de un patrón dentro de un sospechoso. Los punteros pertenecen al
+ * resultado y son válidos hasta dna_result_free. */
+typedef struct dna_hit {
+    const char* marker;
+    const char* pattern;
+    const int64_t* positions;
+    const int32_t* distances;     /* NULL en búsqueda exacta */
+    const char* strands;          /* '+' o '-' de cada posición; NULL sin both_strands */
+    size_t count;                 /* posiciones (0 en las consultas count y top) */
+    uint64_t matches;             /* coincidencias del patrón */
+    int best_distance;            /* -1 en búsqueda exacta */
+    double similarity;
+} dna_hit;
+
+typedef struct dna_result dna_result;
+
+/* Ejecuta la búsqueda. Siempre devuelve un resultado (NULL solo si no hay memoria), que
+ * se libera con dna_result_free; dna_result_success indica si la búsqueda tuvo éxito. */
+dna_result* dna_search(const dna_search_params* params);
+
+int dna_result_success(const dna_result* result);
+const char* dna_result_message(const dna_result* result);
+int64_t dna_result_duration_ms(const dna_result* result);
+
+/* Sospechosos con al menos una coincidencia, en el orden del CSV (con la consulta top, de
+ * más a menos coincidencias). */
+size_t dna_result_suspect_count(const dna_result* result);
+const char* dna_result_suspect_name(const dna_result* result, size_t suspect);
+size_t dna_result_suspect_matches(const dna_result* result, size_t suspect);
+
+/* Patrones con coincidencias en el sospechoso (uno solo fuera del modo panel). */
+size_t dna_result_hit_count(const dna_result* result, size_t suspect);
+int dna_result_hit(const dna_result* result, size_t suspect, size_t hit, dna_hit* out_hit);
+
+void dna_result_free(dna_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+#include "dna_engine.h"
+#include "search_service.hpp"
+#include <new>
+#include <exception>
+
+static_assert(sizeof(int) == sizeof(int32_t), "Las distancias se exponen como int32_t");
+
+struct dna_result {
+    SearchOutcome outcome;
+    std::string pattern; // patrón del modo de un solo patrón (marcador y patrón a la vez)
+};
+
+dna_result* dna_search(const dna_search_params* params) {
+    dna_result* result = new (std::nothrow) dna_result();
+    if (result == nullptr) {
+        return nullptr;
+    }
+    if (params == nullptr || params->algorithm == nullptr || params->pattern_count == 0 || params->patterns == nullptr) {
+        result->outcome.message = "Parámetros de búsqueda incompletos.";
+        return result;
+    }
+
+    // Las excepciones (p. ej. falta de memoria) no pueden cruzar la frontera con C.
+    try {
+        SearchRequest request;
+        if (params->csv_data != nullptr) {
+            request.csv_data = std::string_view(params->csv_data, params->csv_size);
+        } else if (params->csv_path != nullptr) {
+            request.csv_path = params->csv_path;
+        }
+        request.algorithm = params->algorithm;
+        request.options.threads = params->threads;
+        request.options.max_errors = params->max_errors;
+        request.options.both_strands = params->both_strands != 0;
+        request.options.kmer_filter = params->kmer_filter != 0;
+        if (params->result_cache_dir != nullptr) {
+            request.options.result_cache_dir = params->result_cache_dir;
+        }
+        if (params->result_cache_limit != 0) {
+            request.options.result_cache_limit = params->result_cache_limit;
+        }
+        if (params->query != nullptr && !parseQuery(params->query, request.options.query)) {
+            result->outcome.message = "Consulta no válida (exists, count, first=N o top=K).";
+            return result;
+        }
+
+        if (params->markers == nullptr && params->pattern_count == 1) {
+            request.pattern = params->patterns[0] ? params->patterns[0] : "";
+            result->pattern = request.pattern;
+        } else {
+            for (size_t p = 0; p < params->pattern_count; ++p) {
+                std::string pattern = params->patterns[p] ? params->patterns[p] : "";
+                std::string marker = params->markers && params->markers[p] ? params->markers[p] : pattern;
+                request.panel.push_back({marker, pattern});
+            }
+        }
+        result->outcome = runSearch(request);
+    } catch (const std::exception& error) {
+        result->outcome = SearchOutcome();
+        result->outcome.message = std::string("Error interno del motor: ") + error.what();
+    }
+    return result;
+}
+
+int dna_result_success(const dna_result* result) {
+    return result != nullptr && result->outcome.success ? 1 : 0;
+}
+
+const char* dna_result_message(const dna_result* result) {
+    return result ? result->outcome.message.c_str() : "";
+}
+
+int64_t dna_result_duration_ms(const dna_result* result) {
+    return result ? result->outcome.duration_ms : 0;
+}
+
+size_t dna_result_suspect_count(const dna_result* result) {
+    return result ? result->outcome.results.size() : 0;
+}
+
+const char* dna_result_suspect_name(const dna_result* result, size_t suspect) {
+    if (suspect >= dna_result_suspect_count(result)) {
+        return nullptr;
+    }
+    return result->outcome.results[suspect].name.c_str();
+}
+
+size_t dna_result_suspect_matches(const dna_result* result, size_t suspect) {
+    if (suspect >= dna_result_suspect_count(result)) {
+        return 0;
+    }
+    return result->outcome.results[suspect].matches;
+}
+
+size_t dna_result_hit_count(const dna_result* result, size_t suspect) {
+    if (suspect >= dna_result_suspect_count(result)) {
+        return 0;
+    }
+    const ResultEntry& entry = result->outcome.results[suspect];
+    return entry.pattern_hits.empty() ? 1 : entry.pattern_hits.size();
+}
+
+int dna_result_hit(const dna_result* result, size_t suspect, size_t hit, dna_hit* out_hit) {
+    if (out_hit == nullptr || hit >= dna_result_hit_count(result, suspect)) {
+        return 0;
+    }
+    const ResultEntry& entry = result->outcome.results[suspect];
+    if (entry.pattern_hits.empty()) {
+        out_hit->marker = result->pattern.c_str();
+        out_hit->pattern = result->pattern.c_str();
+        out_hit->positions = entry.positions.data();
+        out_hit->distances = entry.distances.empty() ? nullptr : entry.distances.data();
+        out_hit->strands = entry.strands.empty() ? nullptr : entry.strands.data();
+        out_hit->count = entry.positions.size();
+        out_hit->matches = entry.matches;
+        out_hit->best_distance = entry.best_distance;
+        out_hit->similarity = entry.similarity;
+        return 1;
+    }
+    const PatternHits& hits = entry.pattern_hits[hit];
+    out_hit->marker = hits.marker.c_str();
+    out_hit->pattern = hits.pattern.c_str();
+    out_hit->positions = hits.positions.data();
+    out_hit->distances = hits.distances.empty() ? nullptr : hits.distances.data();
+    out_hit->strands = hits.strands.empty() ? nullptr : hits.strands.data();
+    out_hit->count = hits.positions.size();
+    out_hit->matches = hits.matches;
+    out_hit->best_distance = hits.best_distance;
+    out_hit->similarity = hits.similarity;
+    return 1;
+}
+
+void dna_result_free(dna_result* result) {
+    delete result;
+}
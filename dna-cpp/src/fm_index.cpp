@@ -0,0 +1,502 @@
+#include "fm_index.hpp"
+#include "result_cache.hpp"
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+// --- Construcción del arreglo de sufijos (SA-IS) ---
+
+// Símbolos del texto concatenado: el terminador es único y el menor de todos.
+const uint8_t SYMBOL_END = 0;
+const uint8_t SYMBOL_SEPARATOR = 1;
+const uint8_t SYMBOL_FIRST_BASE = 2; // A = 2, C = 3, G = 4, T = 5
+const uint32_t SYMBOL_COUNT = 6;
+
+const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+// Código del texto indexado para cada carácter: las bases ambiguas actúan como separador.
+struct IndexSymbolTable {
+    std::array<uint8_t, 256> symbol;
+
+    IndexSymbolTable() {
+        symbol.fill(SYMBOL_SEPARATOR);
+        symbol['A'] = SYMBOL_FIRST_BASE;     symbol['a'] = SYMBOL_FIRST_BASE;
+        symbol['C'] = SYMBOL_FIRST_BASE + 1; symbol['c'] = SYMBOL_FIRST_BASE + 1;
+        symbol['G'] = SYMBOL_FIRST_BASE + 2; symbol['g'] = SYMBOL_FIRST_BASE + 2;
+        symbol['T'] = SYMBOL_FIRST_BASE + 3; symbol['t'] = SYMBOL_FIRST_BASE + 3;
+    }
+};
+
+static const IndexSymbolTable INDEX_SYMBOL;
+
+// Inicio (o fin, si 'bucket_end') de la zona de cada símbolo en el arreglo de sufijos.
+template <typename Symbol>
+static void getBuckets(const Symbol* text, size_t n, size_t alphabet, std::vector<uint32_t>& buckets, bool bucket_end) {
+    buckets.assign(alphabet, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++buckets[text[i]];
+    }
+    uint32_t sum = 0;
+    for (size_t c = 0; c < alphabet; ++c) {
+        sum += buckets[c];
+        buckets[c] = bucket_end ? sum : sum - buckets[c];
+    }
+}
+
+// Induce el orden de los sufijos tipo L (de izquierda a derecha) y luego el de los tipo S.
+template <typename Symbol>
+static void induceSort(const Symbol* text, uint32_t* sa, size_t n, size_t alphabet,
+                       const std::vector<bool>& s_type, std::vector<uint32_t>& buckets) {
+    getBuckets(text, n, alphabet, buckets, false);
+    for (size_t i = 0; i < n; ++i) {
+        if (sa[i] != EMPTY_SLOT && sa[i] > 0 && !s_type[sa[i] - 1]) {
+            uint32_t j = sa[i] - 1;
+            sa[buckets[text[j]]++] = j;
+        }
+    }
+    getBuckets(text, n, alphabet, buckets, true);
+    for (size_t i = n; i-- > 0;) {
+        if (sa[i] != EMPTY_SLOT && sa[i] > 0 && s_type[sa[i] - 1]) {
+            uint32_t j = sa[i] - 1;
+            sa[--buckets[text[j]]] = j;
+        }
+    }
+}
+
+// SA-IS (Nong, Zhang y Chan): arreglo de sufijos en tiempo lineal. El texto debe terminar
+// en un símbolo 0 único. Los sufijos LMS se ordenan por inducción, se renombran y, si hay
+// nombres repetidos, se resuelve recursivamente el texto reducido.
+template <typename Symbol>
+static void buildSuffixArray(const Symbol* text, uint32_t* sa, size_t n, size_t alphabet) {
+    if (n == 1) {
+        sa[0] = 0;
+        return;
+    }
+
+    std::vector<bool> s_type(n, false);
+    s_type[n - 1] = true;
+    for (size_t i = n - 1; i-- > 0;) {
+        s_type[i] = text[i] < text[i + 1] || (text[i] == text[i + 1] && s_type[i + 1]);
+    }
+    auto is_lms = [&](size_t i) { return i > 0 && s_type[i] && !s_type[i - 1]; };
+
+    // 1) Ordenar las subcadenas LMS
+    std::vector<uint32_t> buckets;
+    getBuckets(text, n, alphabet, buckets, true);
+    std::fill(sa, sa + n, EMPTY_SLOT);
+    for (size_t i = 1; i < n; ++i) {
+        if (is_lms(i)) {
+            sa[--buckets[text[i]]] = i;
+        }
+    }
+    induceSort(text, sa, n, alphabet, s_type, buckets);
+
+    // 2) Compactar las subcadenas LMS ordenadas y asignarles nombres
+    size_t lms_count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (is_lms(sa[i])) {
+            sa[lms_count++] = sa[i];
+        }
+    }
+    std::fill(sa + lms_count, sa + n, EMPTY_SLOT);
+    uint32_t names = 0;
+    size_t previous = n;
+    for (size_t i = 0; i < lms_count; ++i) {
+        size_t position = sa[i];
+        bool different = false;
+        for (size_t d = 0; d < n; ++d) {
+            if (previous == n || text[position + d] != text[previous + d] ||
+                s_type[position + d] != s_type[previous + d]) {
+                different = true;
+                break;
+            }
+            if (d > 0 && (is_lms(position + d) || is_lms(previous + d))) {
+                break;
+            }
+        }
+        if (different) {
+            ++names;
+            previous = position;
+        }
+        sa[lms_count + position / 2] = names - 1;
+    }
+    for (size_t i = n, j = n; i-- > lms_count;) {
+        if (sa[i] != EMPTY_SLOT) {
+            sa[--j] = sa[i];
+        }
+    }
+
+    // 3) Ordenar los sufijos LMS (recursivamente si hay nombres repetidos)
+    uint32_t* reduced = sa + n - lms_count;
+    if (names < lms_count) {
+        buildSuffixArray(reduced, sa, lms_count, names);
+    } else {
+        for (size_t i = 0; i < lms_count; ++i) {
+            sa[reduced[i]] = i;
+        }
+    }
+
+    // 4) Inducir el arreglo completo a partir de los sufijos LMS ordenados
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        if (is_lms(i)) {
+            reduced[j++] = i;
+        }
+    }
+    for (size_t i = 0; i < lms_count; ++i) {
+        sa[i] = reduced[sa[i]];
+    }
+    std::fill(sa + lms_count, sa + n, EMPTY_SLOT);
+    getBuckets(text, n, alphabet, buckets, true);
+    for (size_t i = lms_count; i-- > 0;) {
+        uint32_t j = sa[i];
+        sa[i] = EMPTY_SLOT;
+        sa[--buckets[text[j]]] = j;
+    }
+    induceSort(text, sa, n, alphabet, s_type, buckets);
+}
+
+// --- Formato del archivo ---
+
+static const char FM_MAGIC[8] = {'D', 'N', 'A', 'F', 'M', 'I', '0', '2'};
+
+static size_t alignTo8(size_t bytes) {
+    return (bytes + 7) & ~size_t(7);
+}
+
+// Desplazamientos de cada sección dentro del archivo.
+struct FMLayout {
+    size_t blocks, samples, suspects, names, total;
+
+    explicit FMLayout(const FMIndexHeader& header) {
+        blocks = alignTo8(sizeof(FMIndexHeader));
+        samples = blocks + header.block_count * sizeof(FMBlock);
+        suspects = samples + alignTo8(header.sample_count * sizeof(uint32_t));
+        names = suspects + size_t(header.suspect_count) * sizeof(FMSuspectEntry);
+        total = names + alignTo8(header.names_bytes);
+    }
+};
+
+// Hash de la cabecera (sin el propio checksum) y de todas las secciones. Un byte dañado en
+// los bloques, las muestras o la tabla de sospechosos llevaría las consultas fuera del archivo.
+static uint64_t indexChecksum(const char* data, const FMLayout& layout) {
+    const uint64_t header_hash = hashBytes(data, offsetof(FMIndexHeader, checksum));
+    return hashBytes(data + layout.blocks, layout.total - layout.blocks, header_hash);
+}
+
+bool FMIndex::build(const std::vector<SuspectView>& records, uint64_t source_size, int64_t source_modified) {
+    // Texto concatenado: cada secuencia seguida de un separador, y el terminador al final.
+    uint64_t text_length = 1;
+    uint64_t names_bytes = 0;
+    for (const auto& record : records) {
+        text_length += record.sequence.size() + 1;
+        names_bytes += record.name.size();
+    }
+    if (text_length >= EMPTY_SLOT || records.size() >= EMPTY_SLOT) {
+        std::cerr << "ERROR: El CSV es demasiado grande para el índice FM (máximo 4 Gb)." << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> text;
+    text.reserve(text_length);
+    for (const auto& record : records) {
+        for (char c : record.sequence) {
+            text.push_back(INDEX_SYMBOL.symbol[static_cast<unsigned char>(c)]);
+        }
+        text.push_back(SYMBOL_SEPARATOR);
+    }
+    text.push_back(SYMBOL_END);
+
+    std::vector<uint32_t> suffix_array(text_length);
+    buildSuffixArray(text.data(), suffix_array.data(), text_length, SYMBOL_COUNT);
+
+    FMIndexHeader new_header{};
+    std::memcpy(new_header.magic, FM_MAGIC, sizeof(FM_MAGIC));
+    new_header.source_size = source_size;
+    new_header.source_modified = source_modified;
+    new_header.text_length = text_length;
+    new_header.block_count = text_length / 64 + 1; // un bloque extra para consultar occ(c, n)
+    new_header.names_bytes = names_bytes;
+    new_header.sample_rate = FM_SAMPLE_RATE;
+    new_header.suspect_count = records.size();
+
+    // Se muestrean las posiciones múltiplo de la tasa y las filas cuyo símbolo anterior es
+    // un separador: así el recorrido LF de 'locate' nunca tiene que cruzar un separador.
+    auto is_sampled = [&](uint32_t position) {
+        return position % FM_SAMPLE_RATE == 0 || text[position - 1] < SYMBOL_FIRST_BASE;
+    };
+    uint64_t counts[SYMBOL_COUNT] = {0};
+    for (uint64_t row = 0; row < text_length; ++row) {
+        ++counts[text[suffix_array[row]]];
+        if (is_sampled(suffix_array[row])) {
+            ++new_header.sample_count;
+        }
+    }
+    uint64_t first_row = counts[SYMBOL_END] + counts[SYMBOL_SEPARATOR];
+    for (int code = 0; code < 4; ++code) {
+        new_header.first_row[code] = first_row;
+        first_row += counts[SYMBOL_FIRST_BASE + code];
+    }
+
+    FMLayout layout(new_header);
+    owned.assign(layout.total / sizeof(uint64_t), 0);
+    char* data = reinterpret_cast<char*>(owned.data());
+    std::memcpy(data, &new_header, sizeof(new_header));
+
+    FMBlock* out_blocks = reinterpret_cast<FMBlock*>(data + layout.blocks);
+    uint32_t* out_samples = reinterpret_cast<uint32_t*>(data + layout.samples);
+    uint32_t occ_counts[4] = {0, 0, 0, 0};
+    uint32_t sample_rank = 0;
+    for (uint64_t row = 0; row < text_length; ++row) {
+        FMBlock& block = out_blocks[row / 64];
+        const uint64_t bit = uint64_t(1) << (row % 64);
+        if (row % 64 == 0) {
+            std::memcpy(block.occ, occ_counts, sizeof(occ_counts));
+            block.sample_rank = sample_rank;
+        }
+
+        uint32_t position = suffix_array[row];
+        uint8_t previous = position == 0 ? SYMBOL_END : text[position - 1];
+        if (previous < SYMBOL_FIRST_BASE) {
+            block.separator |= bit;
+        } else {
+            int code = previous - SYMBOL_FIRST_BASE;
+            if (code & 1) block.low |= bit;
+            if (code & 2) block.high |= bit;
+            ++occ_counts[code];
+        }
+        if (is_sampled(position)) {
+            block.sampled |= bit;
+            out_samples[sample_rank++] = position;
+        }
+    }
+    if (text_length % 64 == 0) {
+        FMBlock& block = out_blocks[text_length / 64];
+        std::memcpy(block.occ, occ_counts, sizeof(occ_counts));
+        block.sample_rank = sample_rank;
+    }
+
+    FMSuspectEntry* out_suspects = reinterpret_cast<FMSuspectEntry*>(data + layout.suspects);
+    char* out_names = data + layout.names;
+    uint64_t name_offset = 0;
+    uint64_t start = 0;
+    for (size_t s = 0; s < records.size(); ++s) {
+        out_suspects[s] = {name_offset, static_cast<uint32_t>(records[s].name.size()), static_cast<uint32_t>(start)};
+        std::memcpy(out_names + name_offset, records[s].name.data(), records[s].name.size());
+        name_offset += records[s].name.size();
+        start += records[s].sequence.size() + 1;
+    }
+
+    reinterpret_cast<FMIndexHeader*>(data)->checksum = indexChecksum(data, layout);
+    file.close();
+    return attach(data, layout.total);
+}
+
+bool FMIndex::attach(const char* data, size_t size) {
+    header = nullptr;
+    if (data == nullptr || size < sizeof(FMIndexHeader)) {
+        return false;
+    }
+    const FMIndexHeader* candidate = reinterpret_cast<const FMIndexHeader*>(data);
+    if (std::memcmp(candidate->magic, FM_MAGIC, sizeof(FM_MAGIC)) != 0 || candidate->sample_rate == 0 ||
+        candidate->block_count != candidate->text_length / 64 + 1 || FMLayout(*candidate).total != size) {
+        return false;
+    }
+    FMLayout layout(*candidate);
+    if (candidate->checksum != indexChecksum(data, layout)) {
+        return false;
+    }
+    header = candidate;
+    blocks = reinterpret_cast<const FMBlock*>(data + layout.blocks);
+    samples = reinterpret_cast<const uint32_t*>(data + layout.samples);
+    suspects = reinterpret_cast<const FMSuspectEntry*>(data + layout.suspects);
+    names = data + layout.names;
+    return true;
+}
+
+bool FMIndex::save(const std::string& filename) const {
+    if (owned.empty()) {
+        return false;
+    }
+    // Se escribe en un temporal propio y se renombra, para que otra búsqueda nunca vea un índice
+    // a medias ni otra construcción del mismo CSV trunque el archivo que se está mapeando.
+    const std::string temporary = writerTemporaryPath(filename);
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(owned.data()), owned.size() * sizeof(uint64_t));
+        if (!out) {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FMIndex::load(const std::string& filename) {
+    owned.clear();
+    header = nullptr;
+    if (!file.open(filename, false)) {
+        return false;
+    }
+    if (!attach(file.data(), file.size())) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool FMIndex::matchesSource(uint64_t source_size, int64_t source_modified) const {
+    return header != nullptr && header->source_size == source_size && header->source_modified == source_modified;
+}
+
+size_t FMIndex::suspectCount() const {
+    return header ? header->suspect_count : 0;
+}
+
+std::string_view FMIndex::suspectName(size_t suspect) const {
+    return std::string_view(names + suspects[suspect].name_offset, suspects[suspect].name_length);
+}
+
+// --- Consultas ---
+
+// Filas del bloque (hasta 'bits' exclusive) cuyo símbolo es la base 'code'.
+static inline uint64_t symbolMask(const FMBlock& block, int code) {
+    uint64_t mask = ~block.separator;
+    mask &= (code & 1) ? block.low : ~block.low;
+    mask &= (code & 2) ? block.high : ~block.high;
+    return mask;
+}
+
+static inline uint64_t lowBits(uint64_t row) {
+    return (uint64_t(1) << (row % 64)) - 1;
+}
+
+uint64_t FMIndex::occ(int code, uint64_t row) const {
+    const FMBlock& block = blocks[row / 64];
+    return block.occ[code] + __builtin_popcountll(symbolMask(block, code) & lowBits(row));
+}
+
+bool FMIndex::backwardSearch(const std::string& pattern, uint64_t& first, uint64_t& last) const {
+    if (header == nullptr || pattern.empty()) {
+        return false;
+    }
+    first = 0;
+    last = header->text_length;
+    for (size_t i = pattern.length(); i-- > 0;) {
+        uint8_t symbol = INDEX_SYMBOL.symbol[static_cast<unsigned char>(pattern[i])];
+        if (symbol < SYMBOL_FIRST_BASE) {
+            return false; // los separadores nunca coinciden
+        }
+        int code = symbol - SYMBOL_FIRST_BASE;
+        first = header->first_row[code] + occ(code, first);
+        last = header->first_row[code] + occ(code, last);
+        if (first >= last) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t FMIndex::textPosition(uint64_t row) const {
+    uint64_t steps = 0;
+    while (true) {
+        const FMBlock& block = blocks[row / 64];
+        const uint64_t bit = uint64_t(1) << (row % 64);
+        if (block.sampled & bit) {
+            return samples[block.sample_rank + __builtin_popcountll(block.sampled & lowBits(row))] + steps;
+        }
+        // Paso LF: la fila del sufijo que empieza una posición antes.
+        int code = ((block.low & bit) ? 1 : 0) | ((block.high & bit) ? 2 : 0);
+        row = header->first_row[code] + occ(code, row);
+        ++steps;
+    }
+}
+
+size_t FMIndex::count(const std::string& pattern) const {
+    uint64_t first, last;
+    if (!backwardSearch(pattern, first, last)) {
+        return 0;
+    }
+    return last - first;
+}
+
+void FMIndex::locate(const std::string& pattern, std::vector<std::vector<int64_t>>& positions) const {
+    positions.assign(suspectCount(), {});
+    uint64_t first, last;
+    if (!backwardSearch(pattern, first, last)) {
+        return;
+    }
+
+    std::vector<uint32_t> text_positions;
+    text_positions.reserve(last - first);
+    for (uint64_t row = first; row < last; ++row) {
+        text_positions.push_back(textPosition(row));
+    }
+    std::sort(text_positions.begin(), text_positions.end());
+
+    // Las posiciones ordenadas se reparten recorriendo la tabla de sospechosos una sola vez.
+    size_t suspect = 0;
+    const size_t suspect_count = suspectCount();
+    for (uint32_t text_position : text_positions) {
+        while (suspect + 1 < suspect_count && suspects[suspect + 1].start <= text_position) {
+            ++suspect;
+        }
+        positions[suspect].push_back(text_position - suspects[suspect].start);
+    }
+}
+
+// --- Acceso desde el CSV ---
+
+std::string fmIndexPath(const std::string& csv_path) {
+    return csv_path + FM_INDEX_EXTENSION;
+}
+
+bool loadOrBuildFMIndex(const std::string& csv_path, FMIndex& index) {
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(csv_path, error);
+    uintmax_t size = error ? 0 : std::filesystem::file_size(csv_path, error);
+    if (error) {
+        std::cerr << "ERROR: No se pudo abrir el archivo CSV en la ruta: " << csv_path << std::endl;
+        return false;
+    }
+    const int64_t modified_ticks = modified.time_since_epoch().count();
+
+    const std::string index_path = fmIndexPath(csv_path);
+    if (index.load(index_path) && index.matchesSource(size, modified_ticks)) {
+        return true;
+    }
+
+    // No hay índice o corresponde a otra versión del CSV: se construye de nuevo.
+    MappedSuspectList mapped;
+    if (!loadMappedCSV(csv_path, mapped)) {
+        return false;
+    }
+    if (!index.build(mapped.records, size, modified_ticks)) {
+        return false;
+    }
+    if (!index.save(index_path)) {
+        std::cerr << "ADVERTENCIA: No se pudo guardar el índice FM en " << index_path
+                  << "; se usará solo para esta búsqueda." << std::endl;
+        return true;
+    }
+    // Se pasa a la copia mapeada para liberar la memoria de la construcción.
+    FMIndex mapped_index;
+    if (mapped_index.load(index_path)) {
+        index = std::move(mapped_index);
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+#ifndef FM_INDEX_HPP
+#define FM_INDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "mapped_csv.hpp"
+
+// Extensión del índice, que se guarda junto al CSV (archivo.csv -> archivo.csv.fmi).
+const char* const FM_INDEX_EXTENSION = ".fmi";
+
+// Cada cuántas posiciones del texto se guarda una entrada del arreglo de sufijos.
+// Localizar una coincidencia cuesta a lo sumo FM_SAMPLE_RATE - 1 pasos LF.
+const uint32_t FM_SAMPLE_RATE = 32;
+
+// Cabecera del archivo .fmi. Le siguen, alineados a 8 bytes: los bloques de la BWT, las
+// posiciones muestreadas, la tabla de sospechosos y los nombres. Los enteros se guardan
+// en el orden de bytes de la máquina que construyó el índice.
+struct FMIndexHeader {
+    char magic[8];            // "DNAFMI02"
+    uint64_t source_size;     // tamaño del CSV de origen
+    int64_t source_modified;  // fecha de modificación del CSV de origen
+    uint64_t text_length;     // símbolos del texto concatenado, incluido el terminador
+    uint64_t first_row[4];    // primera fila de la BWT cuyo sufijo empieza con A, C, G, T
+    uint64_t block_count;
+    uint64_t sample_count;
+    uint64_t names_bytes;
+    uint32_t sample_rate;
+    uint32_t suspect_count;
+    uint64_t checksum;        // hashBytes de la cabecera hasta este campo y de todas las secciones
+};
+
+// Sospechoso dentro del texto concatenado: su nombre y dónde empieza su secuencia.
+struct FMSuspectEntry {
+    uint64_t name_offset;
+    uint32_t name_length;
+    uint32_t start;
+};
+
+// Bloque de 64 filas de la BWT: conteos acumulados al inicio del bloque y los símbolos
+// repartidos en dos planos de bits (código de 2 bits) más una máscara de separadores.
+// Los separadores (fin de secuencia o base ambigua) nunca forman parte de un patrón.
+struct FMBlock {
+    uint32_t occ[4];       // apariciones de A, C, G, T antes del bloque
+    uint32_t sample_rank;  // filas muestreadas antes del bloque
+    uint32_t reserved;
+    uint64_t low;          // bit 0 del código de cada fila
+    uint64_t high;         // bit 1 del código de cada fila
+    uint64_t separator;    // filas cuyo símbolo es un separador
+    uint64_t sampled;      // filas con posición guardada en el arreglo de muestras
+};
+
+// Índice FM (BWT + arreglo de sufijos muestreado + tablas de rango) sobre todas las
+// secuencias de un CSV concatenadas. Cuenta las apariciones de un patrón en tiempo
+// proporcional a su longitud y localiza cada una en a lo sumo FM_SAMPLE_RATE pasos,
+// sin recorrer las secuencias. El archivo se usa tal cual mediante mmap: no se copia
+// ni se decodifica al abrirlo, solo se recorre una vez para comprobar su checksum. Las posiciones se guardan en 32 bits (hasta 4 Gb en total).
+class FMIndex {
+public:
+    // Construye el índice en memoria a partir de los registros del CSV. 'source_size' y
+    // 'source_modified' identifican la versión del CSV con la que se construyó.
+    bool build(const std::vector<SuspectView>& suspects, uint64_t source_size, int64_t source_modified);
+
+    // Guarda el índice construido (se escribe en un temporal propio y se renombra).
+    bool save(const std::string& filename) const;
+
+    // Mapea un índice guardado y comprueba su checksum (lo recorre una vez). Retorna false
+    // si no existe, no es válido o está dañado: las consultas confían en sus desplazamientos.
+    bool load(const std::string& filename);
+
+    // Indica si el índice se construyó a partir de esta versión del CSV.
+    bool matchesSource(uint64_t source_size, int64_t source_modified) const;
+
+    size_t suspectCount() const;
+    std::string_view suspectName(size_t suspect) const;
+
+    // Número de apariciones del patrón (solo A, C, G, T) en todas las secuencias.
+    size_t count(const std::string& pattern) const;
+
+    // Posiciones de cada aparición, agrupadas por sospechoso (en el orden del CSV) y en
+    // orden creciente: 'positions' tendrá suspectCount() listas.
+    void locate(const std::string& pattern, std::vector<std::vector<int64_t>>& positions) const;
+
+private:
+    // Representación contigua del archivo: propia (recién construida) o mapeada.
+    std::vector<uint64_t> owned;
+    MappedFile file;
+    const FMIndexHeader* header = nullptr;
+    const FMBlock* blocks = nullptr;
+    const uint32_t* samples = nullptr;
+    const FMSuspectEntry* suspects = nullptr;
+    const char* names = nullptr;
+
+    bool attach(const char* data, size_t size);
+    bool backwardSearch(const std::string& pattern, uint64_t& first, uint64_t& last) const;
+    uint64_t occ(int code, uint64_t row) const;
+    uint64_t textPosition(uint64_t row) const;
+};
+
+// Ruta del índice correspondiente a un CSV.
+std::string fmIndexPath(const std::string& csv_path);
+
+// Abre el índice del CSV y lo reconstruye (y guarda) si no existe, está dañado o el CSV cambió.
+// Si no se puede guardar junto al CSV, el índice recién construido se usa desde memoria.
+bool loadOrBuildFMIndex(const std::string& csv_path, FMIndex& index);
+
+#endif
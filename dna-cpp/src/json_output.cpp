@@ -0,0 +1,26 @@
+#include "json_output.hpp"
+#include "result_writer.hpp"
+#include <fstream>
+#include <iostream>
+
+void writeJSONOutput(std::ostream& outfile, bool success, const std::string& message, 
+                     const std::string& algorithm_name, const std::vector<ResultEntry>& results, 
+                     long long duration_ms, SearchMetrics* metrics) {
+    std::unique_ptr<ResultWriter> writer = makeResultWriter(outfile, OutputFormat::JSON, algorithm_name);
+    for (const auto& entry : results) {
+        writer->write(entry);
+    }
+    writer->finish(success, message, duration_ms, metrics);
+}
+
+void generateJSONOutput(const std::string& outputFilename, bool success, const std::string& message, 
+                        const std::string& algorithm_name, const std::vector<ResultEntry>& results, 
+                        long long duration_ms, SearchMetrics* metrics) {
+    
+    std::ofstream outfile(outputFilename);
+    if (!outfile.is_open()) {
+        std::cerr << "ERROR: No se pudo crear el archivo de salida JSON." << std::endl;
+        return;
+    }
+    writeJSONOutput(outfile, success, message, algorithm_name, results, duration_ms, metrics);
+}
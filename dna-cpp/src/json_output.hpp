@@ -0,0 +1,48 @@
+#ifndef JSON_OUTPUT_HPP
+#define JSON_OUTPUT_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+#include "metrics.hpp"
+
+// Coincidencias de un marcador del panel dentro de un sospechoso (modo multi-patrón)
+struct PatternHits {
+    std::string marker;
+    std::string pattern;
+    size_t matches = 0;         // positions.size(), salvo en las consultas que solo cuentan
+    std::vector<int64_t> positions;
+    std::vector<int> distances; // Solo en búsqueda aproximada
+    std::vector<char> strands;  // Solo con both_strands: '+' o '-' de cada posición
+    int best_distance = -1;     // -1 en búsqueda exacta
+    double similarity = 0.0;    // Porcentaje (0-100) correspondiente a best_distance
+};
+
+// Estructura para la salida JSON
+struct ResultEntry {
+    std::string name;
+    size_t matches;
+    std::vector<int64_t> positions;        // Vacío en las consultas que solo cuentan (count, top)
+    std::vector<PatternHits> pattern_hits; // Solo se llena en modo panel
+    std::vector<int> distances;            // Solo en búsqueda aproximada
+    std::vector<char> strands;             // Solo con both_strands: '+' o '-' de cada posición
+    int best_distance = -1;                // -1 en búsqueda exacta
+    double similarity = 0.0;
+};
+
+// Escribe el documento JSON de resultados en cualquier flujo (archivo o respuesta del servidor).
+// Si se entregan métricas, se completa su tiempo de serialización y se agregan al final
+// como objeto "metrics". Para escribir los sospechosos a medida que se encuentran, sin
+// reunirlos antes en un vector, ver makeResultWriter (result_writer.hpp).
+void writeJSONOutput(std::ostream& out, bool success, const std::string& message,
+                     const std::string& algorithm_name, const std::vector<ResultEntry>& results,
+                     long long duration_ms, SearchMetrics* metrics = nullptr);
+
+// Escribe el documento JSON de resultados en un archivo.
+void generateJSONOutput(const std::string& outputFilename, bool success, const std::string& message,
+                        const std::string& algorithm_name, const std::vector<ResultEntry>& results,
+                        long long duration_ms, SearchMetrics* metrics = nullptr);
+
+#endif
@@ -0,0 +1,272 @@
+#include "kmer_filter.hpp"
+#include "result_cache.hpp"
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+static const char KMER_FILTER_MAGIC[8] = {'D', 'N', 'A', 'K', 'M', 'F', '0', '2'};
+
+// k-mers canónicos distintos que pueden existir (k par): (4^k + 4^(k/2)) / 2, porque cada
+// k-mer y su complemento reverso cuentan una vez y los palíndromos son su propio complemento.
+const uint64_t KMER_DISTINCT_MAX = ((uint64_t(1) << (2 * KMER_LENGTH)) + (uint64_t(1) << KMER_LENGTH)) / 2;
+
+const uint8_t NOT_A_BASE = 4;
+
+// Código de 2 bits de cada base (mayúsculas o minúsculas); NOT_A_BASE para el resto.
+struct KmerCodeTable {
+    std::array<uint8_t, 256> code;
+
+    KmerCodeTable() {
+        code.fill(NOT_A_BASE);
+        code['A'] = 0; code['a'] = 0;
+        code['C'] = 1; code['c'] = 1;
+        code['G'] = 2; code['g'] = 2;
+        code['T'] = 3; code['t'] = 3;
+    }
+};
+
+static const KmerCodeTable KMER_CODE;
+
+// Recorre los k-mers de la secuencia con el mismo esquema rodante de Rabin-Karp: cada base
+// actualiza en O(1) el código del k-mer y el de su complemento reverso, y se entrega el menor.
+// Una base fuera de A, C, G, T reinicia la ventana.
+template <typename Visit>
+static void forEachCanonicalKmer(std::string_view sequence, Visit visit) {
+    const uint64_t mask = (uint64_t(1) << (2 * KMER_LENGTH)) - 1;
+    const unsigned reverse_shift = 2 * (KMER_LENGTH - 1);
+    uint64_t forward = 0;
+    uint64_t reverse = 0;
+    unsigned filled = 0;
+    for (char c : sequence) {
+        const uint8_t code = KMER_CODE.code[static_cast<unsigned char>(c)];
+        if (code == NOT_A_BASE) {
+            filled = 0;
+            continue;
+        }
+        forward = ((forward << 2) | code) & mask;
+        reverse = (reverse >> 2) | (uint64_t(3 - code) << reverse_shift);
+        if (filled < KMER_LENGTH) {
+            ++filled;
+        }
+        if (filled == KMER_LENGTH) {
+            visit(forward < reverse ? forward : reverse);
+        }
+    }
+}
+
+// Mezcla el código del k-mer (finalizador de splitmix64): cada mitad de 32 bits elige una
+// posición del filtro.
+static inline uint64_t mixKmer(uint64_t kmer) {
+    kmer += 0x9E3779B97F4A7C15ull;
+    kmer = (kmer ^ (kmer >> 30)) * 0xBF58476D1CE4E5B9ull;
+    kmer = (kmer ^ (kmer >> 27)) * 0x94D049BB133111EBull;
+    return kmer ^ (kmer >> 31);
+}
+
+// Posición 'i' de la huella dentro de un filtro de 'bits' bits (reducción por multiplicación,
+// sin división ni tamaños potencia de dos).
+static inline uint64_t filterBit(uint64_t hash, unsigned i, uint64_t bits) {
+    return (((hash >> (32 * i)) & 0xFFFFFFFFull) * bits) >> 32;
+}
+
+// Palabras del filtro de una secuencia: KMER_FILTER_BITS_PER_KMER bits por cada k-mer que
+// puede contener, y al menos una (sin k-mers, el filtro vacío descarta cualquier patrón).
+static uint64_t filterWords(size_t length) {
+    const uint64_t kmers = length >= KMER_LENGTH ? std::min<uint64_t>(length - KMER_LENGTH + 1, KMER_DISTINCT_MAX) : 0;
+    return std::max<uint64_t>(1, (kmers * KMER_FILTER_BITS_PER_KMER + 63) / 64);
+}
+
+const size_t KMER_FILTER_HEADER_WORDS = (sizeof(KmerFilterHeader) + 7) / 8;
+
+// Hash de la cabecera (sin el propio checksum), de los inicios y de los filtros: un inicio
+// dañado haría leer fuera del archivo.
+static uint64_t filterChecksum(const char* data, size_t size) {
+    const uint64_t header_hash = hashBytes(data, offsetof(KmerFilterHeader, checksum));
+    const size_t body = KMER_FILTER_HEADER_WORDS * 8;
+    return hashBytes(data + body, size - body, header_hash);
+}
+
+bool KmerFilter::build(const std::vector<SuspectView>& records, uint64_t source_size, int64_t source_modified) {
+    KmerFilterHeader new_header{};
+    std::memcpy(new_header.magic, KMER_FILTER_MAGIC, sizeof(KMER_FILTER_MAGIC));
+    new_header.source_size = source_size;
+    new_header.source_modified = source_modified;
+    new_header.suspect_count = records.size();
+    new_header.kmer_length = KMER_LENGTH;
+    new_header.hash_count = KMER_FILTER_HASHES;
+    for (const auto& record : records) {
+        new_header.word_count += filterWords(record.sequence.size());
+    }
+
+    owned.assign(KMER_FILTER_HEADER_WORDS + records.size() + 1 + new_header.word_count, 0);
+    std::memcpy(owned.data(), &new_header, sizeof(new_header));
+    uint64_t* out_offsets = owned.data() + KMER_FILTER_HEADER_WORDS;
+    uint64_t* out_words = out_offsets + records.size() + 1;
+
+    uint64_t offset = 0;
+    for (size_t s = 0; s < records.size(); ++s) {
+        out_offsets[s] = offset;
+        const uint64_t word_count = filterWords(records[s].sequence.size());
+        uint64_t* filter = out_words + offset;
+        const uint64_t bits = word_count * 64;
+        forEachCanonicalKmer(records[s].sequence, [&](uint64_t kmer) {
+            const uint64_t hash = mixKmer(kmer);
+            for (unsigned i = 0; i < KMER_FILTER_HASHES; ++i) {
+                const uint64_t bit = filterBit(hash, i, bits);
+                filter[bit >> 6] |= uint64_t(1) << (bit & 63);
+            }
+        });
+        offset += word_count;
+    }
+    out_offsets[records.size()] = offset;
+
+    const char* data = reinterpret_cast<const char*>(owned.data());
+    const size_t size = owned.size() * sizeof(uint64_t);
+    reinterpret_cast<KmerFilterHeader*>(owned.data())->checksum = filterChecksum(data, size);
+    file.close();
+    return attach(data, size);
+}
+
+bool KmerFilter::attach(const char* data, size_t size) {
+    header = nullptr;
+    if (data == nullptr || size < sizeof(KmerFilterHeader)) {
+        return false;
+    }
+    const KmerFilterHeader* candidate = reinterpret_cast<const KmerFilterHeader*>(data);
+    if (std::memcmp(candidate->magic, KMER_FILTER_MAGIC, sizeof(KMER_FILTER_MAGIC)) != 0 ||
+        candidate->kmer_length != KMER_LENGTH || candidate->hash_count != KMER_FILTER_HASHES ||
+        size % 8 != 0 ||
+        size / 8 != KMER_FILTER_HEADER_WORDS + candidate->suspect_count + 1 + candidate->word_count ||
+        candidate->checksum != filterChecksum(data, size)) {
+        return false;
+    }
+    const uint64_t* candidate_offsets = reinterpret_cast<const uint64_t*>(data) + KMER_FILTER_HEADER_WORDS;
+    if (candidate_offsets[candidate->suspect_count] != candidate->word_count) {
+        return false;
+    }
+    header = candidate;
+    offsets = candidate_offsets;
+    words = offsets + header->suspect_count + 1;
+    return true;
+}
+
+bool KmerFilter::save(const std::string& filename) const {
+    if (owned.empty()) {
+        return false;
+    }
+    // Se escribe en un temporal propio y se renombra, para que otra búsqueda nunca vea un filtro
+    // a medias ni otra construcción del mismo CSV trunque el archivo que se está mapeando.
+    const std::string temporary = writerTemporaryPath(filename);
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(owned.data()), owned.size() * sizeof(uint64_t));
+        if (!out) {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool KmerFilter::load(const std::string& filename) {
+    owned.clear();
+    header = nullptr;
+    if (!file.open(filename, false)) {
+        return false;
+    }
+    if (!attach(file.data(), file.size())) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool KmerFilter::matchesSource(uint64_t source_size, int64_t source_modified) const {
+    return header != nullptr && header->source_size == source_size && header->source_modified == source_modified;
+}
+
+size_t KmerFilter::suspectCount() const {
+    return header ? header->suspect_count : 0;
+}
+
+bool KmerFilter::mayContain(size_t suspect, const std::vector<uint64_t>& kmers) const {
+    if (suspect >= suspectCount()) {
+        return true;
+    }
+    const uint64_t* filter = words + offsets[suspect];
+    const uint64_t bits = (offsets[suspect + 1] - offsets[suspect]) * 64;
+    for (uint64_t hash : kmers) {
+        for (unsigned i = 0; i < KMER_FILTER_HASHES; ++i) {
+            const uint64_t bit = filterBit(hash, i, bits);
+            if (!((filter[bit >> 6] >> (bit & 63)) & 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<uint64_t> kmerHashes(std::string_view pattern) {
+    std::vector<uint64_t> hashes;
+    forEachCanonicalKmer(pattern, [&](uint64_t kmer) { hashes.push_back(mixKmer(kmer)); });
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    return hashes;
+}
+
+// --- Acceso desde el CSV ---
+
+std::string kmerFilterPath(const std::string& csv_path) {
+    return csv_path + KMER_FILTER_EXTENSION;
+}
+
+bool loadOrBuildKmerFilter(const std::string& csv_path, KmerFilter& filter) {
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(csv_path, error);
+    uintmax_t size = error ? 0 : std::filesystem::file_size(csv_path, error);
+    if (error) {
+        std::cerr << "ERROR: No se pudo abrir el archivo CSV en la ruta: " << csv_path << std::endl;
+        return false;
+    }
+    const int64_t modified_ticks = modified.time_since_epoch().count();
+
+    const std::string filter_path = kmerFilterPath(csv_path);
+    if (filter.load(filter_path) && filter.matchesSource(size, modified_ticks)) {
+        return true;
+    }
+
+    // No hay filtro o corresponde a otra versión del CSV: se construye de nuevo.
+    MappedSuspectList mapped;
+    if (!loadMappedCSV(csv_path, mapped)) {
+        return false;
+    }
+    if (!filter.build(mapped.records, size, modified_ticks)) {
+        return false;
+    }
+    if (!filter.save(filter_path)) {
+        std::cerr << "ADVERTENCIA: No se pudo guardar el prefiltro de k-mers en " << filter_path
+                  << "; se usará solo para esta búsqueda." << std::endl;
+        return true;
+    }
+    // Se pasa a la copia mapeada para liberar la memoria de la construcción.
+    KmerFilter mapped_filter;
+    if (mapped_filter.load(filter_path)) {
+        filter = std::move(mapped_filter);
+    }
+    return true;
+}
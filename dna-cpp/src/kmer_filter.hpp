@@ -0,0 +1,86 @@
+#ifndef KMER_FILTER_HPP
+#define KMER_FILTER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "mapped_csv.hpp"
+
+// Extensión del prefiltro, que se guarda junto al CSV (archivo.csv -> archivo.csv.kmf).
+const char* const KMER_FILTER_EXTENSION = ".kmf";
+
+// Longitud de los k-mers. Los patrones más cortos no tienen ningún k-mer y no se filtran.
+const unsigned KMER_LENGTH = 8;
+
+// Bits del filtro por k-mer distinto que puede tener una secuencia, y posiciones que marca
+// cada k-mer. Con 4 bits y 2 posiciones, un k-mer ausente pasa el filtro ~15 % de las veces.
+const uint64_t KMER_FILTER_BITS_PER_KMER = 4;
+const unsigned KMER_FILTER_HASHES = 2;
+
+// Cabecera del archivo .kmf. Le siguen: el inicio de cada filtro (suspect_count + 1 enteros,
+// en palabras) y las palabras de todos los filtros. Los enteros se guardan en el orden de
+// bytes de la máquina que construyó el filtro.
+struct KmerFilterHeader {
+    char magic[8];            // "DNAKMF02"
+    uint64_t source_size;     // tamaño del CSV de origen
+    int64_t source_modified;  // fecha de modificación del CSV de origen
+    uint64_t suspect_count;
+    uint64_t word_count;
+    uint32_t kmer_length;
+    uint32_t hash_count;
+    uint64_t checksum;        // hashBytes de la cabecera hasta este campo, los inicios y los filtros
+};
+
+// Resumen de cada sospechoso: un filtro de Bloom con sus k-mers canónicos (el menor entre el
+// k-mer y su complemento reverso, así ambas hebras dan el mismo). Si a una secuencia le falta
+// algún k-mer de un patrón, el patrón no puede aparecer en ella y no hace falta recorrerla.
+// El filtro puede dejar pasar secuencias sin coincidencias, pero nunca descarta una que las
+// tenga. El archivo se usa tal cual mediante mmap, como el índice FM.
+class KmerFilter {
+public:
+    // Construye los filtros en memoria a partir de los registros del CSV. 'source_size' y
+    // 'source_modified' identifican la versión del CSV con la que se construyeron.
+    bool build(const std::vector<SuspectView>& suspects, uint64_t source_size, int64_t source_modified);
+
+    // Guarda los filtros construidos (se escribe en un temporal propio y se renombra).
+    bool save(const std::string& filename) const;
+
+    // Mapea un filtro guardado y comprueba su checksum. Retorna false si no existe, no es
+    // válido o está dañado.
+    bool load(const std::string& filename);
+
+    // Indica si el filtro se construyó a partir de esta versión del CSV.
+    bool matchesSource(uint64_t source_size, int64_t source_modified) const;
+
+    size_t suspectCount() const;
+
+    // Indica si la secuencia 'suspect' puede contener todos los k-mers de 'kmers' (huellas
+    // obtenidas con kmerHashes).
+    bool mayContain(size_t suspect, const std::vector<uint64_t>& kmers) const;
+
+private:
+    // Representación contigua del archivo: propia (recién construida) o mapeada.
+    std::vector<uint64_t> owned;
+    MappedFile file;
+    const KmerFilterHeader* header = nullptr;
+    const uint64_t* offsets = nullptr;
+    const uint64_t* words = nullptr;
+
+    bool attach(const char* data, size_t size);
+};
+
+// Huellas de los k-mers canónicos distintos del patrón (los que tienen una base fuera de
+// A, C, G, T se omiten). Vacío si el patrón es más corto que KMER_LENGTH.
+std::vector<uint64_t> kmerHashes(std::string_view pattern);
+
+// Ruta del prefiltro correspondiente a un CSV.
+std::string kmerFilterPath(const std::string& csv_path);
+
+// Abre el prefiltro del CSV y lo reconstruye (y guarda) si no existe, está dañado o el CSV cambió.
+// Si no se puede guardar junto al CSV, el filtro recién construido se usa desde memoria.
+bool loadOrBuildKmerFilter(const std::string& csv_path, KmerFilter& filter);
+
+#endif
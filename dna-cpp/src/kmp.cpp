@@ -27,18 +27,26 @@ std::vector<int> computeLPS(const std::string& pattern) {
 
 // Función de búsqueda KMP.
 // Devuelve las posiciones de las coincidencias, permitiendo solapamientos.
-std::vector<int> KMPSearch(const std::string& text, const std::string& pattern) {
-    int n = text.length();
-    int m = pattern.length();
-    if (m == 0 || n == 0 || m > n) {
-        return {}; 
+std::vector<int64_t> KMPSearch(std::string_view text, const std::string& pattern) {
+    std::vector<int64_t> matches;
+    if (!pattern.empty() && pattern.length() <= text.length()) {
+        KMPSearch(text, pattern, computeLPS(pattern), matches);
     }
+    return matches;
+}
 
-    std::vector<int> lps = computeLPS(pattern);
-    std::vector<int> matches;
+// Recorre el texto con el autómata KMP y llama a found(posición) en cada coincidencia; el
+// recorrido termina en cuanto found retorna false.
+template <typename Found>
+static void scanKMP(std::string_view text, const std::string& pattern, const std::vector<int>& lps, Found found) {
+    const size_t n = text.length();
+    const size_t m = pattern.length();
+    if (m == 0 || n == 0 || m > n) {
+        return; 
+    }
 
-    int i = 0; 
-    int j = 0; 
+    size_t i = 0; 
+    size_t j = 0; 
 
     while (i < n) {
         if (pattern[j] == text[i]) {
@@ -47,7 +55,9 @@ std::vector<int> KMPSearch(const std::string& text, const std::string& pattern)
         }
 
         if (j == m) {
-            matches.push_back(i - j); 
+            if (!found(i - j)) {
+                return;
+            }
             
             j = lps[j - 1]; 
         } else if (i < n && pattern[j] != text[i]) {
@@ -58,6 +68,101 @@ std::vector<int> KMPSearch(const std::string& text, const std::string& pattern)
             }
         }
     }
+}
 
-    return matches;
+void KMPSearch(std::string_view text, const std::string& pattern, const std::vector<int>& lps,
+               std::vector<int64_t>& matches, size_t limit) {
+    if (limit == 0) {
+        return;
+    }
+    const size_t before = matches.size();
+    scanKMP(text, pattern, lps, [&](size_t position) {
+        matches.push_back(position);
+        return matches.size() - before < limit;
+    });
+}
+
+uint64_t KMPCount(std::string_view text, const std::string& pattern, const std::vector<int>& lps) {
+    uint64_t count = 0;
+    scanKMP(text, pattern, lps, [&](size_t) {
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+// Avanza un autómata KMP con el carácter c y retorna true si con él se completa una coincidencia.
+static inline bool advanceKMP(const std::string& pattern, const std::vector<int>& lps, size_t& j, char c) {
+    while (j > 0 && pattern[j] != c) {
+        j = lps[j - 1];
+    }
+    if (pattern[j] == c) {
+        j++;
+    }
+    if (j == pattern.length()) {
+        j = lps[j - 1];
+        return true;
+    }
+    return false;
+}
+
+// Recorre el texto con los dos autómatas a la vez. found_first y found_second retornan false
+// cuando su patrón ya no necesita más coincidencias; el recorrido termina cuando ninguno las necesita.
+template <typename FoundFirst, typename FoundSecond>
+static void scanKMPPair(std::string_view text, const std::string& first, const std::vector<int>& first_lps,
+                        const std::string& second, const std::vector<int>& second_lps, FoundFirst found_first,
+                        FoundSecond found_second) {
+    const size_t n = text.length();
+    if (first.empty() || second.empty() || first.length() > n || second.length() > n) {
+        return;
+    }
+
+    size_t first_j = 0;
+    size_t second_j = 0;
+    bool first_active = true;
+    bool second_active = true;
+
+    for (size_t i = 0; i < n && (first_active || second_active); i++) {
+        if (first_active && advanceKMP(first, first_lps, first_j, text[i])) {
+            first_active = found_first(i + 1 - first.length());
+        }
+        if (second_active && advanceKMP(second, second_lps, second_j, text[i])) {
+            second_active = found_second(i + 1 - second.length());
+        }
+    }
+}
+
+void KMPSearchPair(std::string_view text, const std::string& first, const std::vector<int>& first_lps,
+                   const std::string& second, const std::vector<int>& second_lps,
+                   std::vector<int64_t>& first_matches, std::vector<int64_t>& second_matches, size_t limit) {
+    if (limit == 0) {
+        return;
+    }
+    const size_t first_before = first_matches.size();
+    const size_t second_before = second_matches.size();
+    scanKMPPair(
+        text, first, first_lps, second, second_lps,
+        [&](size_t position) {
+            first_matches.push_back(position);
+            return first_matches.size() - first_before < limit;
+        },
+        [&](size_t position) {
+            second_matches.push_back(position);
+            return second_matches.size() - second_before < limit;
+        });
+}
+
+void KMPCountPair(std::string_view text, const std::string& first, const std::vector<int>& first_lps,
+                  const std::string& second, const std::vector<int>& second_lps, uint64_t& first_count,
+                  uint64_t& second_count) {
+    scanKMPPair(
+        text, first, first_lps, second, second_lps,
+        [&](size_t) {
+            ++first_count;
+            return true;
+        },
+        [&](size_t) {
+            ++second_count;
+            return true;
+        });
 }
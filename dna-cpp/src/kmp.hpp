@@ -3,6 +3,9 @@
 
 #include <string>
 #include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
 
 // Construye la tabla de prefijos más largos que son también sufijos (LPS).
 // Esta tabla optimiza los saltos al haber un desajuste.
@@ -10,6 +13,29 @@ std::vector<int> computeLPS(const std::string& pattern);
 
 // Realiza la búsqueda de un patrón en un texto usando el algoritmo KMP.
 // Devuelve un vector de las posiciones iniciales donde se encuentra el patrón (incluyendo solapamientos).
-std::vector<int> KMPSearch(const std::string& text, const std::string& pattern);
+std::vector<int64_t> KMPSearch(std::string_view text, const std::string& pattern);
+
+// Igual que KMPSearch, con la tabla LPS ya calculada (computeLPS), y agrega las posiciones
+// al final de 'matches': quien busca el mismo patrón en muchas secuencias no reserva memoria
+// en cada búsqueda. El recorrido termina al agregar 'limit' posiciones (p. ej. 1 para saber
+// solo si el patrón aparece).
+void KMPSearch(std::string_view text, const std::string& pattern, const std::vector<int>& lps,
+               std::vector<int64_t>& matches, size_t limit = SIZE_MAX);
+
+// Cuenta las coincidencias (con solapamientos) sin guardar sus posiciones.
+uint64_t KMPCount(std::string_view text, const std::string& pattern, const std::vector<int>& lps);
+
+// Busca dos patrones (p. ej. un patrón y su complemento reverso) en un solo recorrido del
+// texto: cada carácter avanza los dos autómatas KMP. Agrega las posiciones de cada patrón
+// a su vector; cada patrón deja de buscarse al agregar 'limit' posiciones.
+void KMPSearchPair(std::string_view text, const std::string& first, const std::vector<int>& first_lps,
+                   const std::string& second, const std::vector<int>& second_lps,
+                   std::vector<int64_t>& first_matches, std::vector<int64_t>& second_matches,
+                   size_t limit = SIZE_MAX);
+
+// Igual que KMPSearchPair, pero suma las coincidencias de cada patrón a su cuenta.
+void KMPCountPair(std::string_view text, const std::string& first, const std::vector<int>& first_lps,
+                  const std::string& second, const std::vector<int>& second_lps, uint64_t& first_count,
+                  uint64_t& second_count);
 
 #endif // KMP_HPP
@@ -0,0 +1,321 @@
+#include "mapped_csv.hpp"
+#include "simd_search.hpp"
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// --- Archivo mapeado ---
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(mapped_data, other.mapped_data);
+        std::swap(mapped_size, other.mapped_size);
+#ifdef _WIN32
+        std::swap(file_handle, other.file_handle);
+        std::swap(mapping_handle, other.mapping_handle);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filename, bool sequential) {
+    close();
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    file_handle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        close();
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        return true; // Un archivo vacío no se puede mapear, pero es válido.
+    }
+
+    mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        close();
+        return false;
+    }
+    void* view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        close();
+        return false;
+    }
+    mapped_data = static_cast<const char*>(view);
+    mapped_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_data != nullptr) {
+        UnmapViewOfFile(mapped_data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename, bool sequential) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return true; // Un archivo vacío no se puede mapear, pero es válido.
+    }
+
+    void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // El mapeo sigue vigente sin el descriptor.
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    // Si el archivo se recorre de principio a fin se pide lectura anticipada agresiva;
+    // en accesos aleatorios la lectura anticipada solo desperdicia E/S.
+    madvise(view, info.st_size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+    mapped_data = static_cast<const char*>(view);
+    mapped_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_data != nullptr) {
+        munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
+
+#endif
+
+// --- Lectura del CSV ---
+
+bool isValidSequence(std::string_view sequence) {
+    return simdValidBases(sequence);
+}
+
+static const char* findChar(const char* begin, const char* end, char value) {
+    return static_cast<const char*>(std::memchr(begin, value, end - begin));
+}
+
+bool loadMappedCSV(const std::string& filename, MappedSuspectList& out_suspects) {
+    if (!out_suspects.file.open(filename)) {
+        std::cerr << "ERROR: No se pudo abrir el archivo CSV en la ruta: " << filename << std::endl;
+        return false;
+    }
+    return parseCSVBuffer(std::string_view(out_suspects.file.data(), out_suspects.file.size()), out_suspects);
+}
+
+bool loadMappedCSVRange(const std::string& filename, uint64_t begin, uint64_t end, MappedSuspectList& out_suspects) {
+    if (!out_suspects.file.open(filename)) {
+        std::cerr << "ERROR: No se pudo abrir el archivo CSV en la ruta: " << filename << std::endl;
+        return false;
+    }
+    const uint64_t size = out_suspects.file.size();
+    if (begin > end || end > size) {
+        std::cerr << "ERROR: El rango " << begin << ":" << end << " está fuera del archivo CSV (" << size
+                  << " bytes)." << std::endl;
+        return false;
+    }
+    return parseCSVBuffer(std::string_view(out_suspects.file.data() + begin, end - begin), out_suspects, begin == 0);
+}
+
+// Fin de la línea del registro que empieza en 'cursor' (después del '\n'), saltando los saltos
+// de línea que haya dentro de un nombre entre comillas.
+static const char* skipRecord(const char* cursor, const char* end) {
+    const char* field_end = cursor;
+    if (*cursor == '"') {
+        const char* scan = cursor + 1;
+        while (true) {
+            const char* quote = findChar(scan, end, '"');
+            if (quote == nullptr) {
+                return end;
+            }
+            if (quote + 1 < end && quote[1] == '"') {
+                scan = quote + 2;
+                continue;
+            }
+            field_end = quote + 1;
+            break;
+        }
+    }
+    const char* line_end = findChar(field_end, end, '\n');
+    return line_end ? line_end + 1 : end;
+}
+
+std::vector<uint64_t> splitCSVRecords(std::string_view content, size_t count) {
+    std::vector<uint64_t> boundaries = {0};
+    const char* begin = content.data();
+    const char* end = begin + content.size();
+    const char* cursor = begin;
+    if (!content.empty()) {
+        const char* header_end = findChar(cursor, end, '\n');
+        cursor = header_end ? header_end + 1 : end;
+    }
+
+    // Cada rango termina en el primer inicio de registro desde su parte proporcional del archivo.
+    // Se avanza registro por registro (un memchr por línea) para no cortar nunca un nombre entre
+    // comillas que contenga saltos de línea.
+    for (size_t shard = 1; shard < count && cursor < end; ++shard) {
+        const uint64_t target = content.size() * shard / count;
+        while (cursor < end && static_cast<uint64_t>(cursor - begin) < target) {
+            cursor = skipRecord(cursor, end);
+        }
+        if (cursor >= end) {
+            break;
+        }
+        if (static_cast<uint64_t>(cursor - begin) > boundaries.back()) {
+            boundaries.push_back(cursor - begin);
+        }
+    }
+    boundaries.push_back(content.size());
+    return boundaries;
+}
+
+bool parseCSVBuffer(std::string_view content, MappedSuspectList& out_suspects, bool skip_header) {
+    const char* cursor = content.empty() ? nullptr : content.data();
+    const char* end = cursor + content.size();
+
+    // Omitir la línea de cabecera (Nombre,Cadena_ADN)
+    if (cursor != nullptr && skip_header) {
+        const char* header_end = findChar(cursor, end, '\n');
+        cursor = header_end ? header_end + 1 : end;
+    }
+
+    while (cursor < end) {
+        const char* name_begin = cursor;
+        const char* name_end = nullptr;
+        const char* field_end = cursor; // primer carácter después del nombre entre comillas
+        bool escaped_quotes = false;
+
+        // Nombre entre comillas: puede contener comas y comillas escapadas ("").
+        if (*cursor == '"') {
+            name_begin = cursor + 1;
+            const char* scan = name_begin;
+            while (true) {
+                const char* quote = findChar(scan, end, '"');
+                if (quote == nullptr) {
+                    name_end = end; // comillas sin cerrar: el resto del archivo
+                    field_end = end;
+                    break;
+                }
+                if (quote + 1 < end && quote[1] == '"') {
+                    escaped_quotes = true;
+                    scan = quote + 2;
+                    continue;
+                }
+                name_end = quote;
+                field_end = quote + 1;
+                break;
+            }
+        }
+
+        const char* line_end = findChar(field_end, end, '\n');
+        if (line_end == nullptr) {
+            line_end = end;
+        }
+        const char* next_line = line_end < end ? line_end + 1 : end;
+
+        // Asume que las columnas están separadas por coma.
+        const char* comma = findChar(field_end, line_end, ',');
+        if (comma == nullptr) {
+            cursor = next_line; // fila sin secuencia
+            continue;
+        }
+        if (name_end == nullptr) {
+            name_end = comma;
+        }
+
+        // La secuencia termina en la siguiente coma (columnas extra se ignoran) o en el fin de línea.
+        const char* sequence_begin = comma + 1;
+        const char* sequence_end = findChar(sequence_begin, line_end, ',');
+        if (sequence_end == nullptr) {
+            sequence_end = line_end;
+        }
+        if (sequence_end > sequence_begin && sequence_end[-1] == '\r') {
+            --sequence_end;
+        }
+        if (sequence_end - sequence_begin >= 2 && *sequence_begin == '"' && sequence_end[-1] == '"') {
+            ++sequence_begin;
+            --sequence_end;
+        }
+        cursor = next_line;
+
+        if (sequence_end == sequence_begin) {
+            continue;
+        }
+
+        std::string_view name(name_begin, name_end - name_begin);
+        if (escaped_quotes) {
+            std::string unescaped;
+            for (size_t i = 0; i < name.size(); ++i) {
+                unescaped.push_back(name[i]);
+                if (name[i] == '"' && i + 1 < name.size() && name[i + 1] == '"') {
+                    ++i;
+                }
+            }
+            out_suspects.unescaped_names.push_back(std::move(unescaped));
+            name = out_suspects.unescaped_names.back();
+        }
+
+        std::string_view sequence(sequence_begin, sequence_end - sequence_begin);
+        bool valid = isValidSequence(sequence);
+        if (!valid) {
+            ++out_suspects.invalid_sequences;
+        }
+        out_suspects.records.push_back({name, sequence, valid});
+    }
+
+    if (out_suspects.records.empty()) {
+        // Podría ser un archivo vacío o mal formateado (solo cabecera).
+        std::cerr << "ADVERTENCIA: No se encontraron registros válidos en el archivo CSV." << std::endl;
+    }
+    if (out_suspects.invalid_sequences > 0) {
+        std::cerr << "ADVERTENCIA: " << out_suspects.invalid_sequences
+                  << " secuencia(s) contienen caracteres fuera del alfabeto (A, C, G, T, N)." << std::endl;
+    }
+
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef MAPPED_CSV_HPP
+#define MAPPED_CSV_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+
+// Archivo de solo lectura mapeado en memoria (mmap / MapViewOfFile).
+// No se puede copiar: las vistas que apuntan a su contenido dependen de su vida útil.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Mapea el archivo completo. Retorna false si no se pudo abrir o mapear.
+    // 'sequential' indica al sistema que el archivo se leerá de principio a fin; los
+    // índices que se consultan en posiciones arbitrarias deben pasar false.
+    bool open(const std::string& filename, bool sequential = true);
+    void close();
+
+    const char* data() const { return mapped_data; }
+    size_t size() const { return mapped_size; }
+
+private:
+    const char* mapped_data = nullptr;
+    size_t mapped_size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
+// Sospechoso como vistas dentro del archivo mapeado: ni el nombre ni la secuencia se copian.
+struct SuspectView {
+    std::string_view name;
+    std::string_view sequence;
+    bool valid_alphabet; // true si la secuencia solo contiene A, C, G, T o N (mayúsculas o minúsculas)
+};
+
+// Contenido de un CSV (Nombre,Cadena_ADN) cargado sin copias. Las vistas de 'records'
+// son válidas mientras viva este objeto.
+struct MappedSuspectList {
+    MappedFile file;
+    std::vector<SuspectView> records;
+    // Nombres entre comillas con comillas escapadas ("") que hubo que reescribir.
+    std::deque<std::string> unescaped_names;
+    size_t invalid_sequences = 0;
+};
+
+// Indica si la secuencia solo contiene A, C, G, T o N (mayúsculas o minúsculas).
+bool isValidSequence(std::string_view sequence);
+
+// Mapea el CSV y separa los registros en una sola pasada: los delimitadores se buscan
+// con memchr (vectorizado en la biblioteca estándar) y el alfabeto de cada secuencia se
+// valida mientras se recorre. Acepta nombres entre comillas (con comas o "" internas)
+// y finales de línea CRLF. La primera línea (cabecera) se omite.
+// Retorna true en caso de éxito, false si el archivo no se pudo abrir.
+bool loadMappedCSV(const std::string& filename, MappedSuspectList& out_suspects);
+
+// Igual que loadMappedCSV, pero sobre un CSV que ya está en memoria (p. ej. un archivo
+// recibido por el backend). Las vistas apuntan a 'content', que debe seguir vivo. Con
+// skip_header = false la primera línea ya es un registro (un fragmento sin cabecera).
+bool parseCSVBuffer(std::string_view content, MappedSuspectList& out_suspects, bool skip_header = true);
+
+// Igual que loadMappedCSV, pero solo con los registros del rango de bytes [begin, end) del
+// archivo, que debe empezar al inicio de un registro (un límite de splitCSVRecords). La
+// cabecera solo se omite si el rango empieza en 0.
+bool loadMappedCSVRange(const std::string& filename, uint64_t begin, uint64_t end, MappedSuspectList& out_suspects);
+
+// Divide el contenido en a lo sumo 'count' rangos de bytes de tamaño parecido, cada uno
+// formado por registros completos (con las mismas reglas de comillas que parseCSVBuffer). El
+// primero empieza en 0 e incluye la cabecera. Devuelve los límites: rangos + 1 posiciones,
+// la última igual a content.size().
+std::vector<uint64_t> splitCSVRecords(std::string_view content, size_t count);
+
+#endif
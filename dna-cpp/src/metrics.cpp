@@ -0,0 +1,92 @@
+#include "metrics.hpp"
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2 // GetProcessMemoryInfo desde kernel32, sin enlazar psapi
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+uint64_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss; // macOS lo informa en bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // Linux lo informa en KiB
+#endif
+#endif
+}
+
+std::vector<std::pair<const char*, uint64_t>> metricFields(const SearchMetrics& metrics) {
+    const SearchCounters& counters = metrics.counters;
+    return {
+        {"load_ns", metrics.load_ns},
+        {"preprocess_ns", metrics.preprocess_ns},
+        {"search_ns", metrics.search_ns},
+        {"serialize_ns", metrics.serialize_ns},
+        {"cache_ns", metrics.cache_ns},
+        {"result_cache_hits", metrics.result_cache_hits},
+        {"result_cache_misses", metrics.result_cache_misses},
+        {"pipeline_batches", metrics.pipeline_batches},
+        {"read_stall_ns", metrics.read_stall_ns},
+        {"search_stall_ns", metrics.search_stall_ns},
+        {"write_stall_ns", metrics.write_stall_ns},
+        {"search_queue_peak", metrics.search_queue_peak},
+        {"write_queue_peak", metrics.write_queue_peak},
+        {"bytes_scanned", counters.bytes_scanned},
+        {"suspects_processed", counters.suspects_processed},
+        {"rk_verifications", counters.rk_verifications},
+        {"rk_collisions", counters.rk_collisions},
+        {"ac_failure_transitions", counters.ac_failure_transitions},
+        {"kmer_filter_checked", counters.kmer_filter_checked},
+        {"kmer_filter_rejected", counters.kmer_filter_rejected},
+        {"peak_rss_bytes", metrics.peak_rss_bytes},
+    };
+}
+
+void addCounterFields(SearchCounters& counters, const std::vector<std::pair<std::string, uint64_t>>& fields) {
+    static const std::pair<const char*, uint64_t SearchCounters::*> COUNTERS[] = {
+        {"bytes_scanned", &SearchCounters::bytes_scanned},
+        {"suspects_processed", &SearchCounters::suspects_processed},
+        {"rk_verifications", &SearchCounters::rk_verifications},
+        {"rk_collisions", &SearchCounters::rk_collisions},
+        {"ac_failure_transitions", &SearchCounters::ac_failure_transitions},
+        {"kmer_filter_checked", &SearchCounters::kmer_filter_checked},
+        {"kmer_filter_rejected", &SearchCounters::kmer_filter_rejected},
+    };
+    for (const auto& field : fields) {
+        for (const auto& counter : COUNTERS) {
+            if (field.first == counter.first) {
+                counters.*counter.second += field.second;
+            }
+        }
+    }
+}
+
+void writeMetricsJSON(std::ostream& out, const SearchMetrics& metrics) {
+    const auto fields = metricFields(metrics);
+    out << "{\n";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        out << "    \"" << fields[i].first << "\": " << fields[i].second << (i + 1 < fields.size() ? ",\n" : "\n");
+    }
+    out << "  }";
+}
+
+void writeMetricsSummary(std::ostream& out, const SearchMetrics& metrics) {
+    out << "METRICS:";
+    for (const auto& field : metricFields(metrics)) {
+        out << " " << field.first << "=" << field.second;
+    }
+    out << std::endl;
+}
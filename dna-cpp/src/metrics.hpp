@@ -0,0 +1,83 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Contadores de una búsqueda. Cada tarea acumula los suyos en variables locales y se
+// suman al unir los resultados, por lo que no hay operaciones atómicas en el bucle interno.
+struct SearchCounters {
+    uint64_t bytes_scanned = 0;          // bases recorridas (1 byte por base en el CSV)
+    uint64_t suspects_processed = 0;
+    uint64_t rk_verifications = 0;       // ventanas de RK cuyo hash coincide con el del patrón
+    uint64_t rk_collisions = 0;          // verificaciones de RK que no eran coincidencias
+    uint64_t ac_failure_transitions = 0; // transiciones de AC que siguen un enlace de fallo
+    uint64_t kmer_filter_checked = 0;    // sospechosos consultados en el prefiltro de k-mers
+    uint64_t kmer_filter_rejected = 0;   // de ellos, los descartados sin recorrer su secuencia
+
+    void add(const SearchCounters& other) {
+        bytes_scanned += other.bytes_scanned;
+        suspects_processed += other.suspects_processed;
+        rk_verifications += other.rk_verifications;
+        rk_collisions += other.rk_collisions;
+        ac_failure_transitions += other.ac_failure_transitions;
+        kmer_filter_checked += other.kmer_filter_checked;
+        kmer_filter_rejected += other.kmer_filter_rejected;
+    }
+};
+
+// Tiempo de cada fase de una petición (en nanosegundos), contadores y memoria máxima.
+struct SearchMetrics {
+    long long load_ns = 0;       // lectura del CSV (o del índice) y del panel
+    long long preprocess_ns = 0; // construcción del buscador: LPS, autómata, máscaras...
+    long long search_ns = 0;
+    long long serialize_ns = 0;  // escritura del JSON
+    long long cache_ns = 0;      // huella del archivo, consulta y escritura de la caché de resultados
+    uint64_t result_cache_hits = 0;
+    uint64_t result_cache_misses = 0;
+    // Lectura por fragmentos (runStreamPipeline): las etapas trabajan a la vez, así que
+    // load_ns y search_ns son el tiempo ocupado de cada una y no se suman al tiempo total.
+    uint64_t pipeline_batches = 0;  // lotes que pasaron por la tubería
+    long long read_stall_ns = 0;    // lector esperando un lote libre (contrapresión)
+    long long search_stall_ns = 0;  // buscadores esperando lotes leídos (suma de los hilos)
+    long long write_stall_ns = 0;   // escritor esperando el siguiente lote en orden
+    uint64_t search_queue_peak = 0; // máximo de lotes leídos esperando a un buscador
+    uint64_t write_queue_peak = 0;  // máximo de lotes buscados esperando al escritor
+    SearchCounters counters;
+    uint64_t peak_rss_bytes = 0;
+};
+
+// Cronómetro de una fase, con reloj monótono.
+class PhaseTimer {
+public:
+    PhaseTimer() : start(std::chrono::steady_clock::now()) {}
+
+    long long elapsedNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Memoria residente máxima del proceso hasta el momento, en bytes (0 si no se puede obtener).
+uint64_t peakResidentBytes();
+
+// Nombre y valor de cada métrica, en el orden en que aparecen en el JSON y en el resumen.
+std::vector<std::pair<const char*, uint64_t>> metricFields(const SearchMetrics& metrics);
+
+// Suma a 'counters' los contadores de una lista nombre-valor como la de metricFields (p. ej.
+// las métricas de otro proceso). Los tiempos y demás campos se ignoran.
+void addCounterFields(SearchCounters& counters, const std::vector<std::pair<std::string, uint64_t>>& fields);
+
+// Escribe el objeto "metrics" del JSON (sin coma ni salto final).
+void writeMetricsJSON(std::ostream& out, const SearchMetrics& metrics);
+
+// Resumen en una sola línea para registros: "METRICS: load_ns=... peak_rss_bytes=...".
+void writeMetricsSummary(std::ostream& out, const SearchMetrics& metrics);
+
+#endif
@@ -0,0 +1,96 @@
+#include "packed_dna.hpp"
+#include "simd_search.hpp"
+#include <array>
+#include <utility>
+
+// Base complementaria de cada carácter (los que no son A, C, G ni T se conservan).
+struct ComplementTable {
+    std::array<char, 256> base;
+
+    ComplementTable() {
+        for (int c = 0; c < 256; ++c) {
+            base[c] = static_cast<char>(c);
+        }
+        base['A'] = 'T'; base['T'] = 'A'; base['C'] = 'G'; base['G'] = 'C';
+        base['a'] = 't'; base['t'] = 'a'; base['c'] = 'g'; base['g'] = 'c';
+    }
+};
+
+static const ComplementTable COMPLEMENT;
+
+PackedSequence packSequence(std::string_view sequence) {
+    PackedSequence packed;
+    packed.length = sequence.length();
+    packed.bases.assign((packed.length + 31) / 32, 0);
+
+    // La máscara de ambigüedad solo se conserva si la secuencia tiene alguna base ambigua.
+    std::vector<uint64_t> ambiguous((packed.length + 63) / 64, 0);
+    if (simdPackBases(sequence, packed.bases.data(), ambiguous.data())) {
+        packed.ambiguous = std::move(ambiguous);
+    }
+    return packed;
+}
+
+std::string unpackSequence(const PackedSequence& sequence) {
+    static const char BASES[] = {'A', 'C', 'G', 'T', 'N'};
+    std::string text(sequence.length, 'A');
+    for (size_t i = 0; i < sequence.length; ++i) {
+        text[i] = BASES[sequence.codeAt(i)];
+    }
+    return text;
+}
+
+uint64_t PackedSequence::extractWord(size_t pos) const {
+    size_t word = pos >> 5;
+    unsigned shift = (pos & 31) * 2;
+    if (word >= bases.size()) {
+        return 0;
+    }
+    uint64_t value = bases[word] >> shift;
+    if (shift != 0 && word + 1 < bases.size()) {
+        value |= bases[word + 1] << (64 - shift);
+    }
+    return value;
+}
+
+uint32_t PackedSequence::extractAmbiguous(size_t pos) const {
+    size_t word = pos >> 6;
+    unsigned shift = pos & 63;
+    if (!hasAmbiguous() || word >= ambiguous.size()) {
+        return 0;
+    }
+    uint64_t value = ambiguous[word] >> shift;
+    if (shift > 32 && word + 1 < ambiguous.size()) {
+        value |= ambiguous[word + 1] << (64 - shift);
+    }
+    return static_cast<uint32_t>(value);
+}
+
+bool PackedSequence::hasAmbiguousIn(size_t pos, size_t len) const {
+    if (!hasAmbiguous() || len == 0) {
+        return false;
+    }
+    size_t end = pos + len; // exclusivo
+    while (pos < end) {
+        size_t word = pos >> 6;
+        unsigned offset = pos & 63;
+        size_t take = 64 - offset;
+        if (take > end - pos) {
+            take = end - pos;
+        }
+        uint64_t mask = (take == 64) ? ~uint64_t(0) : ((uint64_t(1) << take) - 1) << offset;
+        if (ambiguous[word] & mask) {
+            return true;
+        }
+        pos += take;
+    }
+    return false;
+}
+
+std::string reverseComplement(std::string_view sequence) {
+    std::string reversed(sequence.rbegin(), sequence.rend());
+    for (char& c : reversed) {
+        c = COMPLEMENT.base[static_cast<unsigned char>(c)];
+    }
+    return reversed;
+}
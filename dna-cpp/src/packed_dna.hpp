@@ -0,0 +1,54 @@
+#ifndef PACKED_DNA_HPP
+#define PACKED_DNA_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Código reservado para bases ambiguas (N u otro símbolo fuera de A, C, G, T).
+const int AMBIGUOUS_CODE = 4;
+
+// Secuencia ADN empaquetada a 2 bits por base (32 bases por palabra de 64 bits).
+// Las bases fuera del alfabeto se guardan como A y se marcan en una máscara de
+// ambigüedad (1 bit por base), que solo se reserva si la secuencia la necesita.
+struct PackedSequence {
+    std::vector<uint64_t> bases;
+    std::vector<uint64_t> ambiguous;
+    size_t length = 0;
+
+    bool hasAmbiguous() const { return !ambiguous.empty(); }
+
+    // Código 0-3 de la base i, o AMBIGUOUS_CODE si la base no es A, C, G ni T.
+    int codeAt(size_t i) const {
+        if (hasAmbiguous() && ((ambiguous[i >> 6] >> (i & 63)) & 1)) {
+            return AMBIGUOUS_CODE;
+        }
+        return (bases[i >> 5] >> ((i & 31) * 2)) & 3;
+    }
+
+    // 32 bases consecutivas a partir de la posición pos (las que pasan del final valen 0).
+    uint64_t extractWord(size_t pos) const;
+
+    // Máscara de ambigüedad de 32 bases a partir de pos (bit k = base pos + k).
+    uint32_t extractAmbiguous(size_t pos) const;
+
+    // Indica si hay alguna base ambigua en el rango [pos, pos + len).
+    bool hasAmbiguousIn(size_t pos, size_t len) const;
+
+    // Bytes ocupados por la representación empaquetada.
+    size_t memoryBytes() const { return (bases.size() + ambiguous.size()) * sizeof(uint64_t); }
+};
+
+// Empaqueta una cadena ADN (mayúsculas o minúsculas) en 2 bits por base.
+PackedSequence packSequence(std::string_view sequence);
+
+// Complemento reverso (A<->T, C<->G, conservando mayúsculas o minúsculas): la misma
+// secuencia leída en la hebra opuesta. Los demás caracteres se copian sin cambios.
+std::string reverseComplement(std::string_view sequence);
+
+// Reconstruye la cadena original (las bases ambiguas se devuelven como 'N').
+std::string unpackSequence(const PackedSequence& sequence);
+
+#endif
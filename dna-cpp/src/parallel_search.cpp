@@ -0,0 +1,288 @@
+#include "parallel_search.hpp"
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <mutex>
+
+// Tarea de búsqueda: un grupo de sospechosos completos o un segmento de una sola secuencia.
+struct SearchTask {
+    size_t first_suspect;
+    size_t last_suspect; // exclusivo
+    size_t begin;        // rango dentro de la secuencia (solo para segmentos)
+    size_t end;
+    bool is_segment;
+};
+
+unsigned resolveThreadCount(unsigned requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    unsigned available = std::thread::hardware_concurrency();
+    return available == 0 ? 1 : available;
+}
+
+// Divide el trabajo en tareas de tamaño parecido, conservando el orden de los sospechosos.
+static std::vector<SearchTask> planTasks(size_t suspect_count, const std::function<size_t(size_t)>& length_of) {
+    std::vector<SearchTask> tasks;
+    size_t group_start = 0;
+    size_t group_bases = 0;
+
+    for (size_t s = 0; s < suspect_count; ++s) {
+        size_t length = length_of(s);
+
+        if (length > SEGMENT_LENGTH) {
+            if (group_start < s) {
+                tasks.push_back({group_start, s, 0, 0, false});
+            }
+            for (size_t begin = 0; begin < length; begin += SEGMENT_LENGTH) {
+                size_t end = begin + SEGMENT_LENGTH < length ? begin + SEGMENT_LENGTH : length;
+                tasks.push_back({s, s + 1, begin, end, true});
+            }
+            group_start = s + 1;
+            group_bases = 0;
+            continue;
+        }
+
+        group_bases += length;
+        if (group_bases >= TASK_TARGET_BASES) {
+            tasks.push_back({group_start, s + 1, 0, 0, false});
+            group_start = s + 1;
+            group_bases = 0;
+        }
+    }
+    if (group_start < suspect_count) {
+        tasks.push_back({group_start, suspect_count, 0, 0, false});
+    }
+    return tasks;
+}
+
+// Busca en [begin, end) del sospechoso y agrega sus filas a la tabla.
+using RangeSearch = std::function<void(size_t suspect, size_t begin, size_t end, MatchTable& matches)>;
+
+static void runSearch(size_t suspect_count, unsigned threads, size_t row_count,
+                      const std::function<size_t(size_t)>& length_of, const RangeSearch& search,
+                      const MatchConsumer& consume) {
+    if (threads <= 1) {
+        MatchTable matches;
+        for (size_t s = 0; s < suspect_count; ++s) {
+            matches.clear();
+            search(s, 0, length_of(s), matches);
+            consume(s, matches);
+        }
+        return;
+    }
+
+    std::vector<SearchTask> tasks = planTasks(suspect_count, length_of);
+    std::vector<MatchTable> task_matches(tasks.size());
+    std::vector<char> finished(tasks.size(), 0);
+    std::vector<MatchTable> free_tables; // tablas ya entregadas, para reutilizar su memoria
+    std::mutex mutex;
+    size_t next_emit = 0;
+    bool emitting = false;
+    MatchTable pending; // segmentos ya entregados del sospechoso en curso
+    std::atomic<size_t> next_task(0);
+
+    // Entrega en orden las tareas terminadas. Un solo hilo entrega a la vez y lo hace sin el
+    // candado, así que los demás siguen buscando; si otra tarea termina mientras tanto, el
+    // mismo hilo la entrega en la siguiente vuelta.
+    auto emitReady = [&](std::unique_lock<std::mutex>& lock) {
+        if (emitting) {
+            return;
+        }
+        emitting = true;
+        while (next_emit < tasks.size() && finished[next_emit]) {
+            const size_t t = next_emit++;
+            MatchTable matches = std::move(task_matches[t]);
+            lock.unlock();
+
+            const SearchTask& task = tasks[t];
+            if (!task.is_segment) {
+                consume(task.first_suspect, matches);
+            } else {
+                // Los segmentos de un sospechoso se unen en orden y se entregan con el último.
+                if (pending.rowCount() == 0) {
+                    std::swap(pending, matches);
+                } else {
+                    appendSegment(pending, matches, row_count);
+                }
+                const bool last_segment = t + 1 == tasks.size() || !tasks[t + 1].is_segment ||
+                                          tasks[t + 1].first_suspect != task.first_suspect;
+                if (last_segment) {
+                    consume(task.first_suspect, pending);
+                    pending.clear();
+                }
+            }
+            matches.clear();
+
+            lock.lock();
+            free_tables.push_back(std::move(matches));
+        }
+        emitting = false;
+    };
+
+    // Cada hilo toma la siguiente tarea libre: los núcleos que terminan antes siguen trabajando.
+    auto worker = [&]() {
+        for (size_t t = next_task.fetch_add(1); t < tasks.size(); t = next_task.fetch_add(1)) {
+            MatchTable matches;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!free_tables.empty()) {
+                    matches = std::move(free_tables.back());
+                    free_tables.pop_back();
+                }
+            }
+            const SearchTask& task = tasks[t];
+            if (task.is_segment) {
+                search(task.first_suspect, task.begin, task.end, matches);
+            } else {
+                for (size_t s = task.first_suspect; s < task.last_suspect; ++s) {
+                    search(s, 0, length_of(s), matches);
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            task_matches[t] = std::move(matches);
+            finished[t] = 1;
+            emitReady(lock);
+        }
+    };
+
+    if (threads > tasks.size()) {
+        threads = tasks.size();
+    }
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+void searchSuspects(const SearchEngine& engine, const SuspectList& suspects, unsigned threads, const MatchConsumer& consume) {
+    runSearch(
+        suspects.size(), threads, engine.patternCount(),
+        [&](size_t s) { return suspects[s].second.length(); },
+        [&](size_t s, size_t begin, size_t end, MatchTable& matches) { engine.searchRange(suspects[s].second, begin, end, matches); },
+        consume);
+}
+
+// Consulta el prefiltro antes de recorrer [begin, end) del sospechoso: si lo descarta, agrega
+// sus filas vacías y retorna true. Cada sospechoso se cuenta una sola vez, en su primer segmento.
+static bool rejectedByFilter(const SearchEngine& engine, const KmerFilter* filter, size_t suspect, size_t begin,
+                             MatchTable& matches) {
+    if (filter == nullptr) {
+        return false;
+    }
+    const bool rejected = !engine.passesKmerFilter(*filter, suspect);
+    if (begin == 0) {
+        ++matches.counters.kmer_filter_checked;
+        matches.counters.kmer_filter_rejected += rejected ? 1 : 0;
+    }
+    if (rejected) {
+        engine.skipRange(matches);
+    }
+    return rejected;
+}
+
+void searchSuspects(const SearchEngine& engine, const std::vector<SuspectView>& suspects, unsigned threads, const MatchConsumer& consume,
+                    const KmerFilter* filter) {
+    runSearch(
+        suspects.size(), threads, engine.patternCount(),
+        [&](size_t s) { return suspects[s].sequence.length(); },
+        [&](size_t s, size_t begin, size_t end, MatchTable& matches) {
+            if (!rejectedByFilter(engine, filter, s, begin, matches)) {
+                engine.searchRange(suspects[s].sequence, begin, end, matches);
+            }
+        },
+        consume);
+}
+
+void searchSuspects(const SearchEngine& engine, const PackedSuspectList& suspects, unsigned threads, const MatchConsumer& consume,
+                    const KmerFilter* filter) {
+    runSearch(
+        suspects.size(), threads, engine.patternCount(),
+        [&](size_t s) { return suspects[s].sequence.length; },
+        [&](size_t s, size_t begin, size_t end, MatchTable& matches) {
+            if (!rejectedByFilter(engine, filter, s, begin, matches)) {
+                engine.searchRange(suspects[s].sequence, begin, end, matches);
+            }
+        },
+        consume);
+}
+
+template <typename Suspects>
+static MatchTable collectSuspects(const SearchEngine& engine, const Suspects& suspects, unsigned threads) {
+    MatchTable all_matches;
+    searchSuspects(engine, suspects, threads,
+                   [&](size_t, const MatchTable& matches) { appendRows(all_matches, matches); });
+    return all_matches;
+}
+
+MatchTable searchSuspects(const SearchEngine& engine, const SuspectList& suspects, unsigned threads) {
+    return collectSuspects(engine, suspects, threads);
+}
+
+MatchTable searchSuspects(const SearchEngine& engine, const std::vector<SuspectView>& suspects, unsigned threads) {
+    return collectSuspects(engine, suspects, threads);
+}
+
+MatchTable searchSuspects(const SearchEngine& engine, const PackedSuspectList& suspects, unsigned threads) {
+    return collectSuspects(engine, suspects, threads);
+}
+
+static void runSegments(size_t begin, size_t end, unsigned threads, size_t row_count,
+                        const std::function<void(size_t, size_t, MatchTable&)>& search, MatchTable& matches) {
+    matches.clear();
+    const size_t segment_count = end > begin ? (end - begin + SEGMENT_LENGTH - 1) / SEGMENT_LENGTH : 0;
+    if (threads <= 1 || segment_count <= 1) {
+        search(begin, end, matches);
+        return;
+    }
+
+    std::vector<MatchTable> segment_matches(segment_count);
+    std::atomic<size_t> next_segment(0);
+    auto worker = [&]() {
+        for (size_t t = next_segment.fetch_add(1); t < segment_count; t = next_segment.fetch_add(1)) {
+            size_t segment_begin = begin + t * SEGMENT_LENGTH;
+            size_t segment_end = end - segment_begin > SEGMENT_LENGTH ? segment_begin + SEGMENT_LENGTH : end;
+            search(segment_begin, segment_end, segment_matches[t]);
+        }
+    };
+
+    if (threads > segment_count) {
+        threads = segment_count;
+    }
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    // Los segmentos se unen en orden, así las posiciones quedan ordenadas como en la búsqueda secuencial.
+    for (size_t t = 0; t < segment_count; ++t) {
+        appendSegment(matches, segment_matches[t], row_count);
+    }
+}
+
+void searchSequence(const SearchEngine& engine, std::string_view text, size_t begin, size_t end, unsigned threads,
+                    MatchTable& matches) {
+    runSegments(begin, end, threads, engine.patternCount(),
+                [&](size_t segment_begin, size_t segment_end, MatchTable& segment) {
+                    engine.searchRange(text, segment_begin, segment_end, segment);
+                },
+                matches);
+}
+
+void searchSequence(const SearchEngine& engine, const PackedSequence& text, size_t begin, size_t end, unsigned threads,
+                    MatchTable& matches) {
+    runSegments(begin, end, threads, engine.patternCount(),
+                [&](size_t segment_begin, size_t segment_end, MatchTable& segment) {
+                    engine.searchRange(text, segment_begin, segment_end, segment);
+                },
+                matches);
+}
@@ -0,0 +1,55 @@
+#ifndef PARALLEL_SEARCH_HPP
+#define PARALLEL_SEARCH_HPP
+
+#include <vector>
+#include <functional>
+
+#include "csv_reader.hpp"
+#include "mapped_csv.hpp"
+#include "kmer_filter.hpp"
+#include "search_engine.hpp"
+
+// Secuencias más largas que esto se dividen en segmentos (solapados por la longitud
+// del patrón menos uno) para que un genoma enorme no quede en un solo núcleo.
+const size_t SEGMENT_LENGTH = size_t(1) << 22;
+
+// Los sospechosos cortos se agrupan en tareas de al menos esta cantidad de bases,
+// para que el reparto dinámico no pague una operación atómica por secuencia.
+const size_t TASK_TARGET_BASES = size_t(1) << 16;
+
+// Resuelve el número de hilos pedido: 0 significa "todos los núcleos disponibles".
+unsigned resolveThreadCount(unsigned requested);
+
+// Recibe las coincidencias de los sospechosos [first_suspect, first_suspect + n): la tabla
+// tiene n * engine.patternCount() filas. La tabla se reutiliza después de la llamada.
+using MatchConsumer = std::function<void(size_t first_suspect, const MatchTable& matches)>;
+
+// Busca en todos los sospechosos repartiendo las tareas dinámicamente entre 'threads' hilos.
+// Los resultados se entregan a 'consume' en el orden del CSV, en cuanto están listos todos
+// los sospechosos anteriores, de modo que la salida es idéntica a la de una ejecución
+// secuencial sin importar el número de hilos y no hace falta guardar todas las coincidencias.
+// Las llamadas a 'consume' nunca se solapan.
+// Con 'filter' (el prefiltro de k-mers del mismo CSV, si engine.usesKmerFilter()), las
+// secuencias en las que no puede aparecer ningún patrón se entregan con filas vacías sin
+// recorrerlas.
+void searchSuspects(const SearchEngine& engine, const SuspectList& suspects, unsigned threads, const MatchConsumer& consume);
+void searchSuspects(const SearchEngine& engine, const std::vector<SuspectView>& suspects, unsigned threads, const MatchConsumer& consume,
+                    const KmerFilter* filter = nullptr);
+void searchSuspects(const SearchEngine& engine, const PackedSuspectList& suspects, unsigned threads, const MatchConsumer& consume,
+                    const KmerFilter* filter = nullptr);
+
+// Igual que las anteriores, pero reúne las coincidencias de todos los sospechosos en una tabla.
+MatchTable searchSuspects(const SearchEngine& engine, const SuspectList& suspects, unsigned threads);
+MatchTable searchSuspects(const SearchEngine& engine, const std::vector<SuspectView>& suspects, unsigned threads);
+MatchTable searchSuspects(const SearchEngine& engine, const PackedSuspectList& suspects, unsigned threads);
+
+// Busca en el rango [begin, end) de una sola secuencia (p. ej. un fragmento leído por
+// SequenceStream), dividido en segmentos de SEGMENT_LENGTH bases entre 'threads' hilos, y
+// deja en 'matches' una fila por patrón. Las posiciones quedan en el mismo orden que en la
+// búsqueda secuencial.
+void searchSequence(const SearchEngine& engine, std::string_view text, size_t begin, size_t end, unsigned threads,
+                    MatchTable& matches);
+void searchSequence(const SearchEngine& engine, const PackedSequence& text, size_t begin, size_t end, unsigned threads,
+                    MatchTable& matches);
+
+#endif
@@ -5,41 +5,141 @@ const int Q = 1000000007;
 const int D = 4;
 
 // Función de búsqueda Rabin-Karp.
-std::vector<int> RabinKarpSearch(const std::string& text, const std::string& pattern) {
-    int n = text.length();
-    int m = pattern.length();
+std::vector<int64_t> RabinKarpSearch(std::string_view text, const std::string& pattern, SearchCounters* counters) {
+    std::vector<int64_t> matches;
+    RabinKarpSearch(text, pattern, matches, counters);
+    return matches;
+}
+
+// Compara la ventana que empieza en i con el patrón (tras coincidir el hash).
+static bool verifyWindow(std::string_view text, size_t i, const std::string& pattern) {
+    for (size_t j = 0; j < pattern.length(); j++) {
+        if (text[i + j] != pattern[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Desliza la ventana del hash sobre el texto y llama a found(posición) en cada coincidencia
+// verificada; el recorrido termina en cuanto found retorna false. Suma a 'counters' las
+// verificaciones y las que fueron colisiones.
+template <typename Found>
+static void scanRabinKarp(std::string_view text, const std::string& pattern, SearchCounters* counters, Found found) {
+    const size_t n = text.length();
+    const size_t m = pattern.length();
     if (m == 0 || n == 0 || m > n) {
-        return {};
+        return;
     }
     
-    std::vector<int> matches;
     long long pattern_hash = 0; 
     long long text_hash = 0;   
     long long h = 1;        
+    uint64_t verifications = 0;
+    uint64_t found_count = 0;
 
     // Paso 1: Cálculo inicial de H y H = D^(M-1) mod Q
-    for (int i = 0; i < m - 1; i++) {
+    for (size_t i = 0; i + 1 < m; i++) {
         h = (h * D) % Q;
     }
 
     // Paso 2: Cálculo inicial de los hashes del patrón y la primera ventana de texto
-    for (int i = 0; i < m; i++) {
+    for (size_t i = 0; i < m; i++) {
         pattern_hash = (D * pattern_hash + pattern[i]) % Q;
         text_hash = (D * text_hash + text[i]) % Q;
     }
 
     // Paso 3: Deslizamiento de la ventana
-    for (int i = 0; i <= n - m; i++) {
+    for (size_t i = 0; i <= n - m; i++) {
         if (pattern_hash == text_hash) {
-            bool match = true;
-            for (int j = 0; j < m; j++) {
-                if (text[i + j] != pattern[j]) {
-                    match = false;
+            ++verifications;
+            if (verifyWindow(text, i, pattern)) {
+                ++found_count;
+                if (!found(i)) {
                     break;
                 }
             }
-            if (match) {
-                matches.push_back(i);
+        }
+
+        if (i < n - m) {
+            text_hash = (D * (text_hash - text[i] * h) + text[i + m]) % Q;
+
+            if (text_hash < 0) {
+                text_hash = (text_hash + Q);
+            }
+        }
+    }
+
+    if (counters) {
+        counters->rk_verifications += verifications;
+        counters->rk_collisions += verifications - found_count;
+    }
+}
+
+void RabinKarpSearch(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches,
+                     SearchCounters* counters, size_t limit) {
+    if (limit == 0) {
+        return;
+    }
+    const size_t before = matches.size();
+    scanRabinKarp(text, pattern, counters, [&](size_t position) {
+        matches.push_back(position);
+        return matches.size() - before < limit;
+    });
+}
+
+uint64_t RabinKarpCount(std::string_view text, const std::string& pattern, SearchCounters* counters) {
+    uint64_t count = 0;
+    scanRabinKarp(text, pattern, counters, [&](size_t) {
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+// Recorre el texto con un solo hash rodante para los dos patrones. found_first y found_second
+// retornan false cuando su patrón ya no necesita más coincidencias; el recorrido termina
+// cuando ninguno las necesita.
+template <typename FoundFirst, typename FoundSecond>
+static void scanRabinKarpPair(std::string_view text, const std::string& first, const std::string& second,
+                              SearchCounters* counters, FoundFirst found_first, FoundSecond found_second) {
+    const size_t n = text.length();
+    const size_t m = first.length();
+    if (m == 0 || second.length() != m || n == 0 || m > n) {
+        return;
+    }
+
+    long long first_hash = 0;
+    long long second_hash = 0;
+    long long text_hash = 0;
+    long long h = 1;
+    uint64_t verifications = 0;
+    uint64_t found_count = 0;
+    bool first_active = true;
+    bool second_active = true;
+
+    for (size_t i = 0; i + 1 < m; i++) {
+        h = (h * D) % Q;
+    }
+    for (size_t i = 0; i < m; i++) {
+        first_hash = (D * first_hash + first[i]) % Q;
+        second_hash = (D * second_hash + second[i]) % Q;
+        text_hash = (D * text_hash + text[i]) % Q;
+    }
+
+    for (size_t i = 0; i <= n - m && (first_active || second_active); i++) {
+        if (first_active && text_hash == first_hash) {
+            ++verifications;
+            if (verifyWindow(text, i, first)) {
+                ++found_count;
+                first_active = found_first(i);
+            }
+        }
+        if (second_active && text_hash == second_hash) {
+            ++verifications;
+            if (verifyWindow(text, i, second)) {
+                ++found_count;
+                second_active = found_second(i);
             }
         }
 
@@ -52,5 +152,42 @@ std::vector<int> RabinKarpSearch(const std::string& text, const std::string& pat
         }
     }
 
-    return matches;
+    if (counters) {
+        counters->rk_verifications += verifications;
+        counters->rk_collisions += verifications - found_count;
+    }
+}
+
+void RabinKarpSearchPair(std::string_view text, const std::string& first, const std::string& second,
+                         std::vector<int64_t>& first_matches, std::vector<int64_t>& second_matches,
+                         SearchCounters* counters, size_t limit) {
+    if (limit == 0) {
+        return;
+    }
+    const size_t first_before = first_matches.size();
+    const size_t second_before = second_matches.size();
+    scanRabinKarpPair(
+        text, first, second, counters,
+        [&](size_t position) {
+            first_matches.push_back(position);
+            return first_matches.size() - first_before < limit;
+        },
+        [&](size_t position) {
+            second_matches.push_back(position);
+            return second_matches.size() - second_before < limit;
+        });
+}
+
+void RabinKarpCountPair(std::string_view text, const std::string& first, const std::string& second,
+                        uint64_t& first_count, uint64_t& second_count, SearchCounters* counters) {
+    scanRabinKarpPair(
+        text, first, second, counters,
+        [&](size_t) {
+            ++first_count;
+            return true;
+        },
+        [&](size_t) {
+            ++second_count;
+            return true;
+        });
 }
@@ -3,8 +3,33 @@
 
 #include <string>
 #include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+#include "metrics.hpp"
 
 // Utiliza hashing para encontrar coincidencias.
-std::vector<int> RabinKarpSearch(const std::string& text, const std::string& pattern);
+// Si se entrega 'counters', suma las verificaciones y las colisiones de hash.
+std::vector<int64_t> RabinKarpSearch(std::string_view text, const std::string& pattern, SearchCounters* counters = nullptr);
+
+// Igual que RabinKarpSearch, pero agrega las posiciones al final de 'matches'. El recorrido
+// termina al agregar 'limit' posiciones.
+void RabinKarpSearch(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches,
+                     SearchCounters* counters = nullptr, size_t limit = SIZE_MAX);
+
+// Cuenta las coincidencias sin guardar sus posiciones.
+uint64_t RabinKarpCount(std::string_view text, const std::string& pattern, SearchCounters* counters = nullptr);
+
+// Busca dos patrones de la misma longitud (p. ej. un patrón y su complemento reverso) con un
+// solo hash rodante: cada ventana del texto se compara con los dos hashes de patrón. Cada
+// patrón deja de buscarse al agregar 'limit' posiciones.
+void RabinKarpSearchPair(std::string_view text, const std::string& first, const std::string& second,
+                         std::vector<int64_t>& first_matches, std::vector<int64_t>& second_matches,
+                         SearchCounters* counters = nullptr, size_t limit = SIZE_MAX);
+
+// Igual que RabinKarpSearchPair, pero suma las coincidencias de cada patrón a su cuenta.
+void RabinKarpCountPair(std::string_view text, const std::string& first, const std::string& second,
+                        uint64_t& first_count, uint64_t& second_count, SearchCounters* counters = nullptr);
 
 #endif 
@@ -0,0 +1,317 @@
+#include "result_cache.hpp"
+#include "mapped_csv.hpp"
+#include "result_codec.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+// --- Hash ---
+
+const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t read64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t read32(const unsigned char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t hashRound(uint64_t accumulator, uint64_t input) {
+    accumulator += input * PRIME64_2;
+    return rotateLeft(accumulator, 31) * PRIME64_1;
+}
+
+static inline uint64_t mergeRound(uint64_t accumulator, uint64_t value) {
+    accumulator ^= hashRound(0, value);
+    return accumulator * PRIME64_1 + PRIME64_4;
+}
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        // Cuatro acumuladores independientes: la CPU los avanza en paralelo.
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = hashRound(v1, read64(p));
+            v2 = hashRound(v2, read64(p + 8));
+            v3 = hashRound(v3, read64(p + 16));
+            v4 = hashRound(v4, read64(p + 24));
+        }
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = seed + PRIME64_5;
+    }
+    hash += size;
+
+    for (; p + 8 <= end; p += 8) {
+        hash ^= hashRound(0, read64(p));
+        hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (p + 4 <= end) {
+        hash ^= uint64_t(read32(p)) * PRIME64_1;
+        hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        hash ^= *p * PRIME64_5;
+        hash = rotateLeft(hash, 11) * PRIME64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// Huellas ya calculadas, por ruta. Se descartan todas si crecen demasiado.
+struct FileFingerprint {
+    std::filesystem::file_time_type modified;
+    uint64_t size;
+    uint64_t hash;
+};
+
+const size_t FINGERPRINT_MEMO_CAPACITY = 256;
+
+bool hashInputFile(const std::string& path, uint64_t& content_hash, uint64_t& content_size) {
+    static std::mutex memo_mutex;
+    static std::map<std::string, FileFingerprint> memo;
+
+    std::error_code error;
+    const std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, error);
+    const uintmax_t size = error ? 0 : std::filesystem::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(memo_mutex);
+        auto it = memo.find(path);
+        if (it != memo.end() && it->second.modified == modified && it->second.size == size) {
+            content_hash = it->second.hash;
+            content_size = size;
+            return true;
+        }
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    content_hash = hashBytes(file.data(), file.size());
+    content_size = file.size();
+
+    std::lock_guard<std::mutex> lock(memo_mutex);
+    if (memo.size() >= FINGERPRINT_MEMO_CAPACITY) {
+        memo.clear();
+    }
+    memo[path] = {modified, content_size, content_hash};
+    return true;
+}
+
+std::string ResultCacheKey::fileName() const {
+    const uint64_t id = hashBytes(request.data(), request.size(), content_hash ^ (content_size * PRIME64_3));
+    char name[40];
+    std::snprintf(name, sizeof(name), "cache-%016llx", static_cast<unsigned long long>(id));
+    return std::string(name) + RESULT_CACHE_EXTENSION;
+}
+
+static long processId() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<long>(getpid());
+#endif
+}
+
+std::string writerTemporaryPath(const std::string& path) {
+    // El pid distingue procesos vivos y el contador, cada llamada dentro del proceso.
+    static std::atomic<unsigned long> writer_counter{0};
+    return path + "." + std::to_string(processId()) + "-" + std::to_string(writer_counter++) + ".tmp";
+}
+
+// --- Formato de las entradas ---
+// "DNARES02", la clave completa (para descartar colisiones del nombre), los sospechosos
+// codificados con encodeResult y al final el hash de todo lo anterior.
+
+static const char RESULT_MAGIC[8] = {'D', 'N', 'A', 'R', 'E', 'S', '0', '2'};
+
+static std::string serializeEntry(const ResultCacheKey& key, const std::vector<ResultEntry>& results) {
+    ResultEncoder encoder;
+    encoder.buffer.append(RESULT_MAGIC, sizeof(RESULT_MAGIC));
+    encoder.fixed64(key.content_hash);
+    encoder.fixed64(key.content_size);
+    encoder.text(key.request);
+    encoder.varint(results.size());
+    for (const ResultEntry& entry : results) {
+        encodeResult(encoder, entry);
+    }
+    encoder.fixed64(hashBytes(encoder.buffer.data(), encoder.buffer.size()));
+    return encoder.buffer;
+}
+
+static bool parseEntry(const std::string& content, const ResultCacheKey& key, std::vector<ResultEntry>& results) {
+    const size_t checksum_size = sizeof(uint64_t);
+    if (content.size() < sizeof(RESULT_MAGIC) + checksum_size ||
+        std::memcmp(content.data(), RESULT_MAGIC, sizeof(RESULT_MAGIC)) != 0) {
+        return false;
+    }
+    const size_t body_size = content.size() - checksum_size;
+    uint64_t checksum;
+    std::memcpy(&checksum, content.data() + body_size, checksum_size);
+    if (checksum != hashBytes(content.data(), body_size)) {
+        return false;
+    }
+
+    ResultDecoder decoder(content.data() + sizeof(RESULT_MAGIC), body_size - sizeof(RESULT_MAGIC));
+    if (decoder.fixed64() != key.content_hash || decoder.fixed64() != key.content_size ||
+        decoder.text() != key.request) {
+        return false;
+    }
+    results.clear();
+    results.resize(decoder.count());
+    for (ResultEntry& entry : results) {
+        if (!decodeResult(decoder, entry)) {
+            break;
+        }
+    }
+    if (!decoder.ok || !decoder.atEnd()) {
+        results.clear();
+        return false;
+    }
+    return true;
+}
+
+// --- Caché ---
+
+ResultCache::ResultCache(std::string directory, uint64_t limit_bytes)
+    : directory(std::move(directory)), limit_bytes(limit_bytes) {}
+
+bool ResultCache::load(const ResultCacheKey& key, std::vector<ResultEntry>& results) const {
+    const std::filesystem::path path = std::filesystem::path(directory) / key.fileName();
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    if (!parseEntry(content, key, results)) {
+        return false;
+    }
+
+    // La fecha de modificación registra el último uso para el desalojo LRU.
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+void ResultCache::store(const ResultCacheKey& key, const std::vector<ResultEntry>& results) const {
+    const std::string content = serializeEntry(key, results);
+    if (content.size() > limit_bytes) {
+        return; // la entrada sola no cabe en la caché
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    const std::filesystem::path path = std::filesystem::path(directory) / key.fileName();
+    // Temporal propio de cada escritura: otra búsqueda nunca ve una entrada a medias.
+    const std::filesystem::path temporary = writerTemporaryPath(path.string());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "ADVERTENCIA: No se pudo escribir en la caché de resultados: " << directory << std::endl;
+            return;
+        }
+        out.write(content.data(), content.size());
+        if (!out) {
+            out.close();
+            std::filesystem::remove(temporary, error);
+            std::cerr << "ADVERTENCIA: No se pudo escribir en la caché de resultados: " << directory << std::endl;
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+    evict();
+}
+
+// Borra las entradas usadas hace más tiempo hasta que la carpeta quede bajo el límite.
+// Solo se consideran los archivos .dnr: la carpeta puede tener otros resultados.
+void ResultCache::evict() const {
+    struct CachedFile {
+        std::filesystem::file_time_type used;
+        uintmax_t size;
+        std::filesystem::path path;
+    };
+    std::vector<CachedFile> files;
+    uint64_t total = 0;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() != RESULT_CACHE_EXTENSION || !it->is_regular_file(error)) {
+            continue;
+        }
+        std::error_code file_error;
+        const uintmax_t size = it->file_size(file_error);
+        const std::filesystem::file_time_type used = it->last_write_time(file_error);
+        if (file_error) {
+            continue;
+        }
+        files.push_back({used, size, it->path()});
+        total += size;
+    }
+    if (total <= limit_bytes) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(),
+              [](const CachedFile& a, const CachedFile& b) { return a.used < b.used; });
+    for (const CachedFile& file : files) {
+        if (total <= limit_bytes) {
+            break;
+        }
+        std::error_code remove_error;
+        if (std::filesystem::remove(file.path, remove_error)) {
+            total -= file.size;
+        }
+    }
+}
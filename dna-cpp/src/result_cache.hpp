@@ -0,0 +1,66 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "json_output.hpp"
+
+// Extensión de las entradas de la caché de resultados (cache-<clave>.dnr).
+const char* const RESULT_CACHE_EXTENSION = ".dnr";
+
+// Tamaño máximo por defecto de la carpeta de caché (256 MiB).
+const uint64_t DEFAULT_RESULT_CACHE_LIMIT = uint64_t(256) << 20;
+
+// Hash no criptográfico de 64 bits (XXH64), a varios GB/s.
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+// Temporal propio de quien escribe 'path' (id del proceso y un contador por proceso): dos
+// escrituras del mismo archivo, en hilos o procesos distintos, nunca comparten el temporal
+// que se renombra.
+std::string writerTemporaryPath(const std::string& path);
+
+// Huella del contenido de un archivo. Se recuerda por ruta, tamaño y fecha de modificación,
+// de modo que en el modo servidor un archivo que no cambió no se vuelve a leer.
+// Retorna false si el archivo no se pudo abrir.
+bool hashInputFile(const std::string& path, uint64_t& content_hash, uint64_t& content_size);
+
+// Clave de una búsqueda: huella del archivo de entrada y descripción normalizada de todo
+// lo que cambia el resultado (algoritmo, patrones, opciones). Los hilos y la lectura por
+// fragmentos no forman parte de la clave porque no cambian las coincidencias.
+struct ResultCacheKey {
+    uint64_t content_hash = 0;
+    uint64_t content_size = 0;
+    std::string request;
+
+    // Nombre del archivo de la entrada: cache-<16 dígitos hexadecimales>.dnr
+    std::string fileName() const;
+};
+
+// Caché de resultados en disco, compartida entre procesos. Cada entrada es un archivo
+// binario compacto (posiciones en diferencias con varint) que se escribe en un temporal y
+// se renombra. La fecha de modificación marca el último uso: al superar 'limit_bytes' se
+// borran las entradas usadas hace más tiempo (LRU). Como la clave incluye la huella del
+// contenido, una entrada nunca se usa para un archivo distinto.
+class ResultCache {
+public:
+    ResultCache(std::string directory, uint64_t limit_bytes);
+
+    // Lee la entrada de la clave. Retorna false si no existe, es de otra petición o está dañada.
+    bool load(const ResultCacheKey& key, std::vector<ResultEntry>& results) const;
+
+    // Guarda los resultados y aplica el límite de tamaño. Los errores de escritura solo se
+    // informan como advertencia: la caché nunca hace fallar una búsqueda.
+    void store(const ResultCacheKey& key, const std::vector<ResultEntry>& results) const;
+
+private:
+    std::string directory;
+    uint64_t limit_bytes;
+
+    void evict() const;
+};
+
+#endif
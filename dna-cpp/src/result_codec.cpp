@@ -0,0 +1,43 @@
+#include "result_codec.hpp"
+
+void encodeResult(ResultEncoder& encoder, const ResultEntry& entry) {
+    encoder.text(entry.name);
+    encoder.varint(entry.matches);
+    encoder.positions(entry.positions);
+    encoder.distances(entry.distances);
+    encoder.strands(entry.strands);
+    encoder.similarity(entry.best_distance, entry.similarity);
+    encoder.varint(entry.pattern_hits.size());
+    for (const PatternHits& hits : entry.pattern_hits) {
+        encoder.text(hits.marker);
+        encoder.text(hits.pattern);
+        encoder.varint(hits.matches);
+        encoder.positions(hits.positions);
+        encoder.distances(hits.distances);
+        encoder.strands(hits.strands);
+        encoder.similarity(hits.best_distance, hits.similarity);
+    }
+}
+
+bool decodeResult(ResultDecoder& decoder, ResultEntry& entry) {
+    entry.name = decoder.text();
+    entry.matches = decoder.varint();
+    decoder.positions(entry.positions);
+    decoder.distances(entry.distances);
+    decoder.strands(entry.strands);
+    decoder.similarity(entry.best_distance, entry.similarity);
+    entry.pattern_hits.resize(decoder.count());
+    for (PatternHits& hits : entry.pattern_hits) {
+        hits.marker = decoder.text();
+        hits.pattern = decoder.text();
+        hits.matches = decoder.varint();
+        decoder.positions(hits.positions);
+        decoder.distances(hits.distances);
+        decoder.strands(hits.strands);
+        decoder.similarity(hits.best_distance, hits.similarity);
+        if (!decoder.ok) {
+            break;
+        }
+    }
+    return decoder.ok;
+}
@@ -0,0 +1,157 @@
+#ifndef RESULT_CODEC_HPP
+#define RESULT_CODEC_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "json_output.hpp"
+
+// Codificación binaria compacta de los resultados, compartida por la caché de resultados y la
+// salida binaria. Los enteros van en varint (LEB128); las posiciones de cada lista, que están
+// ordenadas, como diferencias con la anterior, así que en secuencias repetitivas la mayoría
+// ocupa un solo byte.
+class ResultEncoder {
+public:
+    std::string buffer;
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    void fixed64(uint64_t value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void text(std::string_view value) {
+        varint(value.size());
+        buffer.append(value.data(), value.size());
+    }
+
+    void positions(const std::vector<int64_t>& values) {
+        varint(values.size());
+        int64_t previous = 0;
+        for (int64_t value : values) {
+            varint(static_cast<uint64_t>(value - previous));
+            previous = value;
+        }
+    }
+
+    void distances(const std::vector<int>& values) {
+        varint(values.size());
+        for (int value : values) {
+            varint(static_cast<uint32_t>(value));
+        }
+    }
+
+    void strands(const std::vector<char>& values) {
+        text(std::string_view(values.data(), values.size()));
+    }
+
+    void similarity(int best_distance, double value) {
+        varint(static_cast<uint64_t>(best_distance + 1)); // -1 (exacta) se guarda como 0
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        fixed64(bits);
+    }
+};
+
+// Lector con verificación de límites: cualquier lectura fuera del búfer deja 'ok' en false.
+class ResultDecoder {
+public:
+    ResultDecoder(const char* data, size_t size) : cursor(data), end(data + size) {}
+
+    bool ok = true;
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (cursor == end) {
+                break;
+            }
+            const unsigned char byte = static_cast<unsigned char>(*cursor++);
+            value |= uint64_t(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    uint64_t fixed64() {
+        uint64_t value = 0;
+        if (static_cast<size_t>(end - cursor) < sizeof(value)) {
+            ok = false;
+            return 0;
+        }
+        std::memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+        return value;
+    }
+
+    // Cantidad de elementos de una lista; nunca más que los bytes que quedan.
+    size_t count() {
+        const uint64_t value = varint();
+        if (value > static_cast<uint64_t>(end - cursor)) {
+            ok = false;
+            return 0;
+        }
+        return static_cast<size_t>(value);
+    }
+
+    std::string text() {
+        const size_t length = count();
+        std::string value(cursor, ok ? length : 0);
+        cursor += value.size();
+        return value;
+    }
+
+    void positions(std::vector<int64_t>& values) {
+        values.resize(count());
+        int64_t previous = 0;
+        for (int64_t& value : values) {
+            previous += static_cast<int64_t>(varint());
+            value = previous;
+        }
+    }
+
+    void distances(std::vector<int>& values) {
+        values.resize(count());
+        for (int& value : values) {
+            value = static_cast<int>(varint());
+        }
+    }
+
+    void strands(std::vector<char>& values) {
+        const std::string value = text();
+        values.assign(value.begin(), value.end());
+    }
+
+    void similarity(int& best_distance, double& value) {
+        best_distance = static_cast<int>(varint()) - 1;
+        const uint64_t bits = fixed64();
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+
+    bool atEnd() const { return cursor == end; }
+
+private:
+    const char* cursor;
+    const char* end;
+};
+
+// Agrega un sospechoso completo (nombre, posiciones, distancias, hebras y marcadores del panel).
+void encodeResult(ResultEncoder& encoder, const ResultEntry& entry);
+
+// Lee un sospechoso escrito por encodeResult. Retorna false si los datos están incompletos.
+bool decodeResult(ResultDecoder& decoder, ResultEntry& entry);
+
+#endif
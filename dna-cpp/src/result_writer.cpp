@@ -0,0 +1,426 @@
+#include "result_writer.hpp"
+#include "result_codec.hpp"
+#include <cstdio>
+
+// Bytes que se acumulan antes de pasarlos al flujo.
+const size_t WRITE_BUFFER_SIZE = size_t(1) << 16;
+
+bool parseOutputFormat(const std::string& name, OutputFormat& format) {
+    if (name == "json") {
+        format = OutputFormat::JSON;
+    } else if (name == "ndjson") {
+        format = OutputFormat::NDJSON;
+    } else if (name == "binary") {
+        format = OutputFormat::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// --- Formato de números y cadenas ---
+
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+void appendInteger(std::string& out, int64_t value) {
+    char digits[24];
+    char* const end = digits + sizeof(digits);
+    char* p = end;
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    while (magnitude >= 100) {
+        const size_t pair = static_cast<size_t>(magnitude % 100) * 2;
+        magnitude /= 100;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    }
+    if (magnitude >= 10) {
+        const size_t pair = static_cast<size_t>(magnitude) * 2;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    } else {
+        *--p = static_cast<char>('0' + magnitude);
+    }
+    if (value < 0) {
+        *--p = '-';
+    }
+    out.append(p, end - p);
+}
+
+void appendJSONString(std::string& out, std::string_view value) {
+    static const char HEX[] = "0123456789abcdef";
+    out.push_back('"');
+    size_t run_start = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        // Los tramos sin caracteres especiales se copian de una vez.
+        out.append(value.data() + run_start, i - run_start);
+        run_start = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                out += "\\u00";
+                out.push_back(HEX[c >> 4]);
+                out.push_back(HEX[c & 0xF]);
+        }
+    }
+    out.append(value.data() + run_start, value.size() - run_start);
+    out.push_back('"');
+}
+
+// Mismo formato que 'out << value' con la precisión por defecto (6 cifras significativas).
+static void appendDouble(std::string& out, double value) {
+    char text[32];
+    const int length = std::snprintf(text, sizeof(text), "%g", value);
+    out.append(text, length > 0 ? static_cast<size_t>(length) : 0);
+}
+
+// --- Sospechosos en JSON ---
+
+// Separadores del documento indentado (JSON) y de una sola línea (NDJSON).
+struct JSONStyle {
+    const char* object_open;  // apertura del sospechoso y sangría del primer campo
+    const char* field;        // entre campos del sospechoso
+    const char* object_close;
+    const char* list;         // entre elementos de una lista y entre campos de un marcador
+    const char* key;          // entre la clave y el valor
+    const char* patterns_open;
+    const char* pattern;      // entre marcadores
+    const char* patterns_close;
+};
+
+static const JSONStyle PRETTY_STYLE = {"    {\n      ", ",\n      ", "\n    }", ", ", ": ",
+                                       "[\n        ", ",\n        ", "\n      ]"};
+static const JSONStyle COMPACT_STYLE = {"{", ",", "}", ",", ":", "[", ",", "]"};
+
+static void appendKey(std::string& out, const char* key, const JSONStyle& style) {
+    out.push_back('"');
+    out += key;
+    out.push_back('"');
+    out += style.key;
+}
+
+template <typename T>
+static void appendIntList(std::string& out, const std::vector<T>& values, const JSONStyle& style) {
+    out.push_back('[');
+    for (size_t j = 0; j < values.size(); ++j) {
+        if (j > 0) out += style.list;
+        appendInteger(out, values[j]);
+    }
+    out.push_back(']');
+}
+
+// Hebra de cada posición como una lista de cadenas ("+" o "-").
+static void appendStrandList(std::string& out, const std::vector<char>& strands, const JSONStyle& style) {
+    out.push_back('[');
+    for (size_t j = 0; j < strands.size(); ++j) {
+        if (j > 0) out += style.list;
+        out.push_back('"');
+        out.push_back(strands[j]);
+        out.push_back('"');
+    }
+    out.push_back(']');
+}
+
+// Posiciones de un sospechoso o de un marcador, con sus distancias y hebras si las tiene,
+// cada lista precedida de 'separator'. Las consultas que solo cuentan no tienen posiciones y
+// no se escribe ninguna lista.
+static void appendHits(std::string& out, const std::vector<int64_t>& positions, const std::vector<int>& distances,
+                       const std::vector<char>& strands, int best_distance, const char* separator,
+                       const JSONStyle& style) {
+    if (positions.empty()) {
+        return;
+    }
+    out += separator;
+    appendKey(out, "positions", style);
+    appendIntList(out, positions, style);
+    if (best_distance >= 0) {
+        out += separator;
+        appendKey(out, "distances", style);
+        appendIntList(out, distances, style);
+    }
+    if (!strands.empty()) {
+        out += separator;
+        appendKey(out, "strands", style);
+        appendStrandList(out, strands, style);
+    }
+}
+
+static void appendSuspect(std::string& out, const ResultEntry& entry, const JSONStyle& style) {
+    out += style.object_open;
+    appendKey(out, "name", style);
+    appendJSONString(out, entry.name);
+    out += style.field;
+    appendKey(out, "matches_count", style);
+    appendInteger(out, static_cast<int64_t>(entry.matches));
+
+    if (!entry.pattern_hits.empty()) {
+        // Modo panel: coincidencias agrupadas por marcador
+        out += style.field;
+        appendKey(out, "patterns", style);
+        out += style.patterns_open;
+        for (size_t k = 0; k < entry.pattern_hits.size(); ++k) {
+            const PatternHits& hits = entry.pattern_hits[k];
+            if (k > 0) out += style.pattern;
+            out.push_back('{');
+            appendKey(out, "marker", style);
+            appendJSONString(out, hits.marker);
+            out += style.list;
+            appendKey(out, "pattern", style);
+            appendJSONString(out, hits.pattern);
+            out += style.list;
+            appendKey(out, "matches_count", style);
+            appendInteger(out, static_cast<int64_t>(hits.matches));
+            if (hits.best_distance >= 0) {
+                out += style.list;
+                appendKey(out, "best_distance", style);
+                appendInteger(out, hits.best_distance);
+                out += style.list;
+                appendKey(out, "similarity", style);
+                appendDouble(out, hits.similarity);
+            }
+            appendHits(out, hits.positions, hits.distances, hits.strands, hits.best_distance, style.list, style);
+            out.push_back('}');
+        }
+        out += style.patterns_close;
+    } else {
+        // Búsqueda aproximada: mejor distancia y similitud del sospechoso
+        if (entry.best_distance >= 0) {
+            out += style.field;
+            appendKey(out, "best_distance", style);
+            appendInteger(out, entry.best_distance);
+            out += style.field;
+            appendKey(out, "similarity", style);
+            appendDouble(out, entry.similarity);
+        }
+        appendHits(out, entry.positions, entry.distances, entry.strands, entry.best_distance, style.field, style);
+    }
+    out += style.object_close;
+}
+
+// Objeto "metrics" en el estilo del documento.
+static void appendMetrics(std::string& out, const SearchMetrics& metrics, bool pretty) {
+    const auto fields = metricFields(metrics);
+    out += pretty ? "{\n" : "{";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) out += pretty ? ",\n" : ",";
+        if (pretty) out += "    ";
+        out.push_back('"');
+        out += fields[i].first;
+        out += pretty ? "\": " : "\":";
+        appendInteger(out, static_cast<int64_t>(fields[i].second));
+    }
+    out += pretty ? "\n  }" : "}";
+}
+
+// --- Escritores ---
+
+// Base de los escritores: acumula en un búfer y mide el tiempo de escritura.
+class BufferedResultWriter : public ResultWriter {
+public:
+    explicit BufferedResultWriter(std::ostream& out) : out(out) { buffer.reserve(WRITE_BUFFER_SIZE * 2); }
+
+    void write(const ResultEntry& entry) override {
+        if (entry.matches == 0) {
+            return; // solo se incluyen los sospechosos con coincidencias
+        }
+        PhaseTimer timer;
+        writeEntry(entry);
+        if (buffer.size() >= WRITE_BUFFER_SIZE) {
+            flush();
+        }
+        written_ns += timer.elapsedNs();
+    }
+
+    void finish(bool success, const std::string& message, long long duration_ms, SearchMetrics* metrics) override {
+        PhaseTimer timer;
+        if (metrics) {
+            // El cierre todavía no está escrito: se cuenta hasta aquí y se completa al final.
+            metrics->serialize_ns = written_ns + timer.elapsedNs();
+        }
+        writeSummary(success, message, duration_ms, metrics);
+        flush();
+        out.flush();
+    }
+
+protected:
+    std::ostream& out;
+    std::string buffer;
+
+    virtual void writeEntry(const ResultEntry& entry) = 0;
+    virtual void writeSummary(bool success, const std::string& message, long long duration_ms,
+                              const SearchMetrics* metrics) = 0;
+
+private:
+    long long written_ns = 0;
+
+    void flush() {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+};
+
+class JSONResultWriter : public BufferedResultWriter {
+public:
+    JSONResultWriter(std::ostream& out, const std::string& algorithm_name) : BufferedResultWriter(out) {
+        buffer += "{\n  \"algorithm\": ";
+        appendJSONString(buffer, algorithm_name);
+        buffer += ",\n  \"suspects\": [\n";
+    }
+
+protected:
+    void writeEntry(const ResultEntry& entry) override {
+        if (!first_suspect) {
+            buffer += ",\n";
+        }
+        first_suspect = false;
+        appendSuspect(buffer, entry, PRETTY_STYLE);
+    }
+
+    void writeSummary(bool success, const std::string& message, long long duration_ms,
+                      const SearchMetrics* metrics) override {
+        buffer += first_suspect ? "  ],\n" : "\n  ],\n";
+        buffer += "  \"success\": ";
+        buffer += success ? "true" : "false";
+        buffer += ",\n  \"message\": ";
+        appendJSONString(buffer, message);
+        buffer += ",\n  \"processing_time_ms\": ";
+        appendInteger(buffer, duration_ms);
+        if (metrics) {
+            buffer += ",\n  \"metrics\": ";
+            appendMetrics(buffer, *metrics, true);
+        }
+        buffer += "\n}\n";
+    }
+
+private:
+    bool first_suspect = true;
+};
+
+class NDJSONResultWriter : public BufferedResultWriter {
+public:
+    NDJSONResultWriter(std::ostream& out, const std::string& algorithm_name)
+        : BufferedResultWriter(out), algorithm_name(algorithm_name) {}
+
+protected:
+    void writeEntry(const ResultEntry& entry) override {
+        appendSuspect(buffer, entry, COMPACT_STYLE);
+        buffer.push_back('\n');
+    }
+
+    void writeSummary(bool success, const std::string& message, long long duration_ms,
+                      const SearchMetrics* metrics) override {
+        buffer += "{\"success\":";
+        buffer += success ? "true" : "false";
+        buffer += ",\"message\":";
+        appendJSONString(buffer, message);
+        buffer += ",\"algorithm\":";
+        appendJSONString(buffer, algorithm_name);
+        buffer += ",\"processing_time_ms\":";
+        appendInteger(buffer, duration_ms);
+        if (metrics) {
+            buffer += ",\"metrics\":";
+            appendMetrics(buffer, *metrics, false);
+        }
+        buffer += "}\n";
+    }
+
+private:
+    std::string algorithm_name;
+};
+
+// "DNAOUT02", el algoritmo, cada sospechoso precedido de un 1 y, tras un 0, el estado de la
+// búsqueda y las métricas como pares nombre-valor.
+static const char OUTPUT_MAGIC[8] = {'D', 'N', 'A', 'O', 'U', 'T', '0', '2'};
+
+class BinaryResultWriter : public BufferedResultWriter {
+public:
+    BinaryResultWriter(std::ostream& out, const std::string& algorithm_name) : BufferedResultWriter(out) {
+        buffer.append(OUTPUT_MAGIC, sizeof(OUTPUT_MAGIC));
+        swapBuffers();
+        encoder.text(algorithm_name);
+        swapBuffers();
+    }
+
+protected:
+    void writeEntry(const ResultEntry& entry) override {
+        swapBuffers();
+        encoder.varint(1);
+        encodeResult(encoder, entry);
+        swapBuffers();
+    }
+
+    void writeSummary(bool success, const std::string& message, long long duration_ms,
+                      const SearchMetrics* metrics) override {
+        swapBuffers();
+        encoder.varint(0);
+        encoder.varint(success ? 1 : 0);
+        encoder.text(message);
+        encoder.varint(static_cast<uint64_t>(duration_ms));
+        if (metrics) {
+            const auto fields = metricFields(*metrics);
+            encoder.varint(fields.size());
+            for (const auto& field : fields) {
+                encoder.text(field.first);
+                encoder.varint(field.second);
+            }
+        } else {
+            encoder.varint(0);
+        }
+        swapBuffers();
+    }
+
+private:
+    ResultEncoder encoder;
+
+    // El codificador escribe directamente en el búfer del escritor: se intercambian antes
+    // y después de codificar, sin copiar.
+    void swapBuffers() { encoder.buffer.swap(buffer); }
+};
+
+bool readBinaryResults(std::string_view data, BinaryResults& results) {
+    if (data.size() < sizeof(OUTPUT_MAGIC) || data.compare(0, sizeof(OUTPUT_MAGIC), std::string_view(OUTPUT_MAGIC, sizeof(OUTPUT_MAGIC))) != 0) {
+        return false;
+    }
+    ResultDecoder decoder(data.data() + sizeof(OUTPUT_MAGIC), data.size() - sizeof(OUTPUT_MAGIC));
+    results = BinaryResults();
+    results.algorithm = decoder.text();
+    while (decoder.ok && decoder.varint() == 1) {
+        results.suspects.emplace_back();
+        if (!decodeResult(decoder, results.suspects.back())) {
+            return false;
+        }
+    }
+    results.success = decoder.varint() == 1;
+    results.message = decoder.text();
+    results.duration_ms = static_cast<long long>(decoder.varint());
+    const size_t metric_count = decoder.count();
+    for (size_t i = 0; i < metric_count && decoder.ok; ++i) {
+        std::string name = decoder.text();
+        const uint64_t value = decoder.varint();
+        results.metrics.emplace_back(std::move(name), value);
+    }
+    return decoder.ok && decoder.atEnd();
+}
+
+std::unique_ptr<ResultWriter> makeResultWriter(std::ostream& out, OutputFormat format,
+                                               const std::string& algorithm_name) {
+    switch (format) {
+        case OutputFormat::NDJSON: return std::unique_ptr<ResultWriter>(new NDJSONResultWriter(out, algorithm_name));
+        case OutputFormat::BINARY: return std::unique_ptr<ResultWriter>(new BinaryResultWriter(out, algorithm_name));
+        default: return std::unique_ptr<ResultWriter>(new JSONResultWriter(out, algorithm_name));
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef RESULT_WRITER_HPP
+#define RESULT_WRITER_HPP
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "json_output.hpp"
+#include "metrics.hpp"
+
+// Formato del documento de resultados.
+// - JSON: un objeto con "suspects" y, al final, el estado de la búsqueda y las métricas.
+// - NDJSON: un sospechoso por línea y una última línea con el estado y las métricas.
+// - BINARY: posiciones en diferencias con varint (ver README), para consumidores que no
+//   necesitan texto.
+enum class OutputFormat { JSON, NDJSON, BINARY };
+
+// "json", "ndjson" o "binary". Retorna false si el nombre no es válido.
+bool parseOutputFormat(const std::string& name, OutputFormat& format);
+
+// Destino de los sospechosos con coincidencias, que llegan en el orden del CSV a medida que
+// termina su búsqueda.
+class ResultSink {
+public:
+    virtual ~ResultSink() = default;
+    virtual void write(const ResultEntry& entry) = 0;
+};
+
+// Escribe los sospechosos en el flujo a medida que llegan, sin guardarlos. El estado de la
+// búsqueda va al final del documento, así que también es correcto si la búsqueda falla
+// después de escribir algunos sospechosos.
+class ResultWriter : public ResultSink {
+public:
+    // Cierra el documento. Si se entregan métricas, se suma a su serialize_ns el tiempo del
+    // cierre y se agregan al documento.
+    virtual void finish(bool success, const std::string& message, long long duration_ms,
+                        SearchMetrics* metrics = nullptr) = 0;
+};
+
+std::unique_ptr<ResultWriter> makeResultWriter(std::ostream& out, OutputFormat format,
+                                               const std::string& algorithm_name);
+
+// Contenido de un documento escrito con OutputFormat::BINARY.
+struct BinaryResults {
+    std::string algorithm;
+    std::vector<ResultEntry> suspects;
+    bool success = false;
+    std::string message;
+    long long duration_ms = 0;
+    std::vector<std::pair<std::string, uint64_t>> metrics; // en el orden de metricFields
+};
+
+// Lee un documento binario completo. Retorna false si está incompleto, dañado o no es de este
+// formato.
+bool readBinaryResults(std::string_view data, BinaryResults& results);
+
+// Agrega el entero en decimal. Escribe dos cifras por paso con una tabla, sin pasar por
+// los flujos de C++ ni por la configuración regional.
+void appendInteger(std::string& out, int64_t value);
+
+// Agrega el texto como cadena JSON (entre comillas), escapando comillas, barras invertidas
+// y caracteres de control. Los bytes UTF-8 se copian sin cambios.
+void appendJSONString(std::string& out, std::string_view value);
+
+#endif
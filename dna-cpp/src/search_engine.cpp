@@ -0,0 +1,406 @@
+#include "search_engine.hpp"
+#include "kmp.hpp"
+#include "rabin_karp.hpp"
+#include "simd_search.hpp"
+#include <algorithm>
+
+SearchEngine::SearchEngine(const std::string& algorithm_name, const std::vector<std::string>& patterns,
+                           int max_errors, bool both_strands, const Query& query)
+    : algorithm(algorithm_name), patterns(patterns), max_errors(max_errors > 0 ? max_errors : 0),
+      both_strands(both_strands), position_limit(query.positionLimit()), counts_only(query.countsOnly()) {
+
+    if (both_strands) {
+        for (const auto& pattern : patterns) {
+            this->patterns.push_back(reverseComplement(pattern));
+        }
+    }
+
+    for (const auto& pattern : this->patterns) {
+        if (pattern.length() > max_pattern_length) {
+            max_pattern_length = pattern.length();
+        }
+    }
+
+    if (algorithm == "KMP") {
+        for (const auto& pattern : this->patterns) {
+            kmp_tables.push_back(computeLPS(pattern));
+        }
+    } else if (algorithm == "AC") {
+        automaton.reset(new AhoCorasickAutomaton(this->patterns));
+    } else if (algorithm == "BP") {
+        for (const auto& pattern : this->patterns) {
+            bit_parallel_matchers.emplace_back(pattern);
+        }
+    } else if (isApproximate()) {
+        for (const auto& pattern : this->patterns) {
+            approximate_matchers.emplace_back(pattern, max_errors, algorithm == "HD");
+        }
+    }
+
+    // Basta con los patrones entregados: sus complementos reversos tienen las mismas huellas.
+    if (!isApproximate() && !usesIndex()) {
+        for (const auto& pattern : patterns) {
+            kmer_hashes.push_back(kmerHashes(pattern));
+            if (kmer_hashes.back().empty()) {
+                kmer_hashes.clear();
+                break;
+            }
+        }
+    }
+}
+
+bool SearchEngine::passesKmerFilter(const KmerFilter& filter, size_t suspect) const {
+    for (const auto& hashes : kmer_hashes) {
+        if (filter.mayContain(suspect, hashes)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SearchEngine::skipRange(MatchTable& matches) const {
+    for (size_t p = 0; p < patterns.size(); ++p) {
+        if (counts_only) {
+            matches.closeRow(0);
+        } else {
+            matches.closeRow();
+        }
+    }
+}
+
+bool SearchEngine::isValidAlgorithm(const std::string& algorithm_name) {
+    return algorithm_name == "KMP" || algorithm_name == "RK" ||
+           algorithm_name == "AC" || algorithm_name == "BP" ||
+           algorithm_name == "ED" || algorithm_name == "HD" ||
+           algorithm_name == "FM" || algorithm_name == "SIMD";
+}
+
+bool parseQuery(const std::string& text, Query& query) {
+    const size_t equals = text.find('=');
+    const std::string name = text.substr(0, equals);
+    if (equals == std::string::npos) {
+        if (name == "all") {
+            query = Query();
+        } else if (name == "exists") {
+            query = {QueryMode::EXISTS, 1};
+        } else if (name == "count") {
+            query = {QueryMode::COUNT, 0};
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const std::string value = text.substr(equals + 1);
+    if (value.empty() || value.size() > 18 || value.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    const size_t limit = std::stoull(value);
+    if (limit == 0) {
+        return false;
+    }
+    if (name == "first") {
+        query = {QueryMode::FIRST, limit};
+    } else if (name == "top") {
+        query = {QueryMode::TOP, limit};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string queryName(const Query& query) {
+    switch (query.mode) {
+        case QueryMode::EXISTS: return "exists";
+        case QueryMode::COUNT: return "count";
+        case QueryMode::FIRST: return "first=" + std::to_string(query.limit);
+        case QueryMode::TOP: return "top=" + std::to_string(query.limit);
+        default: return "all";
+    }
+}
+
+void appendRows(MatchTable& target, const MatchTable& source) {
+    const size_t shift = target.positions.size();
+    target.positions.insert(target.positions.end(), source.positions.begin(), source.positions.end());
+    target.distances.insert(target.distances.end(), source.distances.begin(), source.distances.end());
+    target.counts.insert(target.counts.end(), source.counts.begin(), source.counts.end());
+    for (size_t row = 1; row < source.offsets.size(); ++row) {
+        target.offsets.push_back(source.offsets[row] + shift);
+    }
+    target.counters.add(source.counters);
+}
+
+void appendSegment(MatchTable& target, const MatchTable& segment, size_t row_count) {
+    if (target.rowCount() == 0) {
+        appendRows(target, segment);
+        return;
+    }
+    if (target.hasCounts()) {
+        // Solo cuentas: se suman fila a fila.
+        for (size_t row = 0; row < row_count; ++row) {
+            target.counts[row] += segment.counts[row];
+        }
+        target.counters.add(segment.counters);
+        return;
+    }
+    if (row_count == 1) {
+        // Una sola fila: basta con agregar al final.
+        target.positions.insert(target.positions.end(), segment.positions.begin(), segment.positions.end());
+        target.distances.insert(target.distances.end(), segment.distances.begin(), segment.distances.end());
+        target.offsets.back() = target.positions.size();
+        target.counters.add(segment.counters);
+        return;
+    }
+    // Con varios patrones las filas se intercalan: se arma la tabla unida y se reemplaza.
+    MatchTable merged;
+    merged.positions.reserve(target.positions.size() + segment.positions.size());
+    const bool with_distances = target.hasDistances() || segment.hasDistances();
+    for (size_t row = 0; row < row_count; ++row) {
+        for (const MatchTable* part : {static_cast<const MatchTable*>(&target), &segment}) {
+            const size_t first = part->offsets[row];
+            const size_t last = part->offsets[row + 1];
+            merged.positions.insert(merged.positions.end(), part->positions.begin() + first,
+                                    part->positions.begin() + last);
+            if (with_distances) {
+                merged.distances.insert(merged.distances.end(), part->distances.begin() + first,
+                                        part->distances.begin() + last);
+            }
+        }
+        merged.closeRow();
+    }
+    merged.counters = target.counters;
+    merged.counters.add(segment.counters);
+    target = std::move(merged);
+}
+
+bool SearchEngine::hasEnoughMatches(const MatchTable& matches, size_t first_row) const {
+    if (position_limit == SIZE_MAX || counts_only || matches.rowCount() < first_row + patterns.size()) {
+        return false;
+    }
+    // Con ambas hebras basta con que una de las dos filas del patrón esté completa: las
+    // posiciones de los fragmentos siguientes son todas mayores.
+    const size_t forward = both_strands ? patterns.size() / 2 : patterns.size();
+    for (size_t p = 0; p < forward; ++p) {
+        size_t found = matches.rowSize(first_row + p);
+        if (both_strands && matches.rowSize(first_row + forward + p) > found) {
+            found = matches.rowSize(first_row + forward + p);
+        }
+        if (found < position_limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Cierra la fila con las posiciones agregadas desde la anterior: las pasa de relativas a la
+// ventana a absolutas ('shift'), descarta las que empiezan en el solapamiento (>= end) y las
+// que sobran según la consulta. Si la consulta solo cuenta, la fila guarda su cantidad.
+void SearchEngine::finishRow(MatchTable& matches, size_t shift, size_t end) const {
+    std::vector<int64_t>& positions = matches.positions;
+    const size_t row_start = matches.offsets.back();
+    if (shift != 0) {
+        for (size_t i = row_start; i < positions.size(); ++i) {
+            positions[i] += shift;
+        }
+    }
+    while (positions.size() > row_start && static_cast<size_t>(positions.back()) >= end) {
+        positions.pop_back();
+    }
+    if (positions.size() - row_start > position_limit) {
+        positions.resize(row_start + position_limit);
+    }
+    if (counts_only) {
+        const uint64_t count = positions.size() - row_start;
+        positions.resize(row_start);
+        matches.distances.resize(matches.hasDistances() ? row_start : 0);
+        matches.closeRow(count);
+        return;
+    }
+    if (matches.distances.size() > positions.size()) {
+        matches.distances.resize(positions.size());
+    }
+    matches.closeRow();
+}
+
+// Listas por patrón de cada hilo, para los buscadores que no producen las filas en orden (AC,
+// que encuentra todos los patrones a la vez, y la búsqueda de ambas hebras). Conservan su
+// capacidad entre búsquedas.
+static std::vector<std::vector<int64_t>>& scratchLists(size_t count) {
+    thread_local std::vector<std::vector<int64_t>> lists;
+    if (lists.size() < count) {
+        lists.resize(count);
+    }
+    for (size_t p = 0; p < count; ++p) {
+        lists[p].clear();
+    }
+    return lists;
+}
+
+// Bases que recorrió un buscador que se detiene al reunir 'limit' posiciones de un patrón de
+// longitud 'length' (las agregadas a 'positions' desde 'first', relativas a la ventana): hasta
+// el final de la última si llegó al límite, o la ventana completa.
+static size_t scannedLength(const std::vector<int64_t>& positions, size_t first, size_t limit, size_t length,
+                            size_t window_length) {
+    if (positions.size() - first < limit) {
+        return window_length;
+    }
+    return static_cast<size_t>(positions.back()) + length;
+}
+
+// Cuentas por patrón de cada hilo (AC y ambas hebras en las consultas que cuentan).
+static std::vector<uint64_t>& scratchCounts(size_t count) {
+    thread_local std::vector<uint64_t> counts;
+    counts.assign(count, 0);
+    return counts;
+}
+
+// Ventana de un patrón de longitud 'length' para buscar las coincidencias que comienzan en
+// [begin, end): todas las que encuentre empiezan antes de end.
+static std::string_view patternWindow(std::string_view text, size_t begin, size_t end, size_t length) {
+    size_t window_end = end + (length > 0 ? length - 1 : 0);
+    if (window_end > text.length()) {
+        window_end = text.length();
+    }
+    return begin < window_end ? text.substr(begin, window_end - begin) : std::string_view();
+}
+
+void SearchEngine::searchRange(std::string_view text, size_t begin, size_t end, MatchTable& matches) const {
+    size_t window_end = end + (max_pattern_length > 0 ? max_pattern_length - 1 : 0);
+    if (window_end > text.length()) {
+        window_end = text.length();
+    }
+    std::string_view window = begin < window_end ? text.substr(begin, window_end - begin) : std::string_view();
+
+    if (counts_only && algorithm != "SIMD") {
+        countRange(text, begin, end, matches);
+        return;
+    }
+
+    // --- LÓGICA DE SELECCIÓN DEL ALGORITMO ---
+    if (automaton) {
+        std::vector<std::vector<int64_t>>& lists = scratchLists(patterns.size());
+        automaton->search(window, lists, &matches.counters, position_limit);
+        // El recorrido termina cuando el último patrón llega al límite.
+        size_t scanned = 0;
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            scanned = std::max(scanned, scannedLength(lists[p], 0, position_limit, patterns[p].length(),
+                                                      window.length()));
+        }
+        matches.counters.bytes_scanned += scanned;
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            matches.positions.insert(matches.positions.end(), lists[p].begin(), lists[p].end());
+            finishRow(matches, begin, end);
+        }
+    } else if (both_strands && algorithm != "SIMD") {
+        // Cada patrón y su complemento reverso se comparan en el mismo recorrido de la ventana.
+        // Las filas de la hebra directa van primero, así que las del complemento esperan en
+        // listas auxiliares.
+        const size_t forward = patterns.size() / 2;
+        std::vector<std::vector<int64_t>>& reverse_lists = scratchLists(forward);
+        for (size_t p = 0; p < forward; ++p) {
+            const size_t row_start = matches.positions.size();
+            if (algorithm == "KMP") {
+                KMPSearchPair(window, patterns[p], kmp_tables[p], patterns[forward + p], kmp_tables[forward + p],
+                              matches.positions, reverse_lists[p], position_limit);
+            } else {
+                RabinKarpSearchPair(window, patterns[p], patterns[forward + p], matches.positions,
+                                    reverse_lists[p], &matches.counters, position_limit);
+            }
+            const size_t length = patterns[p].length();
+            matches.counters.bytes_scanned +=
+                std::max(scannedLength(matches.positions, row_start, position_limit, length, window.length()),
+                         scannedLength(reverse_lists[p], 0, position_limit, length, window.length()));
+            finishRow(matches, begin, end);
+        }
+        for (size_t p = 0; p < forward; ++p) {
+            matches.positions.insert(matches.positions.end(), reverse_lists[p].begin(), reverse_lists[p].end());
+            finishRow(matches, begin, end);
+        }
+    } else {
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            const size_t row_start = matches.positions.size();
+            if (algorithm == "KMP") {
+                KMPSearch(window, patterns[p], kmp_tables[p], matches.positions, position_limit);
+            } else if (algorithm == "SIMD") {
+                SimdSearch(window, patterns[p], matches.positions);
+            } else {
+                RabinKarpSearch(window, patterns[p], matches.positions, &matches.counters, position_limit);
+            }
+            // SIMD no se detiene antes: recorre siempre la ventana completa.
+            matches.counters.bytes_scanned +=
+                algorithm == "SIMD" ? window.length()
+                                    : scannedLength(matches.positions, row_start, position_limit,
+                                                    patterns[p].length(), window.length());
+            finishRow(matches, begin, end);
+        }
+    }
+}
+
+// Consultas que solo cuentan, en KMP, RK y AC: los buscadores suman las coincidencias sin
+// guardar posiciones. KMP y RK recorren la ventana propia de cada patrón, así que no hay
+// coincidencias en el solapamiento que descartar; AC las descarta al contar.
+void SearchEngine::countRange(std::string_view text, size_t begin, size_t end, MatchTable& matches) const {
+    if (automaton) {
+        std::string_view window = patternWindow(text, begin, end, max_pattern_length);
+        std::vector<uint64_t>& counts = scratchCounts(patterns.size());
+        automaton->count(window, end - begin, counts, &matches.counters);
+        matches.counters.bytes_scanned += window.length();
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            matches.closeRow(counts[p]);
+        }
+    } else if (both_strands) {
+        const size_t forward = patterns.size() / 2;
+        std::vector<uint64_t>& reverse_counts = scratchCounts(forward);
+        for (size_t p = 0; p < forward; ++p) {
+            std::string_view window = patternWindow(text, begin, end, patterns[p].length());
+            uint64_t count = 0;
+            if (algorithm == "KMP") {
+                KMPCountPair(window, patterns[p], kmp_tables[p], patterns[forward + p], kmp_tables[forward + p],
+                             count, reverse_counts[p]);
+            } else {
+                RabinKarpCountPair(window, patterns[p], patterns[forward + p], count, reverse_counts[p],
+                                   &matches.counters);
+            }
+            matches.counters.bytes_scanned += window.length();
+            matches.closeRow(count);
+        }
+        for (size_t p = 0; p < forward; ++p) {
+            matches.closeRow(reverse_counts[p]);
+        }
+    } else {
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            std::string_view window = patternWindow(text, begin, end, patterns[p].length());
+            if (algorithm == "KMP") {
+                matches.closeRow(KMPCount(window, patterns[p], kmp_tables[p]));
+            } else {
+                matches.closeRow(RabinKarpCount(window, patterns[p], &matches.counters));
+            }
+            matches.counters.bytes_scanned += window.length();
+        }
+    }
+}
+
+void SearchEngine::searchRange(const PackedSequence& text, size_t begin, size_t end, MatchTable& matches) const {
+    size_t window_end = end + (max_pattern_length > 0 ? max_pattern_length - 1 : 0);
+
+    if (window_end > text.length) {
+        window_end = text.length;
+    }
+
+    const size_t window_length = begin < window_end ? window_end - begin : 0;
+    if (isApproximate()) {
+        // El buscador aproximado ya lee el contexto que necesita alrededor del rango.
+        for (const auto& matcher : approximate_matchers) {
+            matcher.search(text, begin, end, matches.positions, matches.distances);
+            matches.counters.bytes_scanned += window_length;
+            finishRow(matches, 0, end);
+        }
+        return;
+    }
+
+    for (const auto& matcher : bit_parallel_matchers) {
+        matcher.search(text, begin, window_end, matches.positions);
+        matches.counters.bytes_scanned += window_length;
+        finishRow(matches, 0, end);
+    }
+}
@@ -0,0 +1,177 @@
+#ifndef SEARCH_ENGINE_HPP
+#define SEARCH_ENGINE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "aho_corasick.hpp"
+#include "bit_parallel.hpp"
+#include "approximate.hpp"
+#include "kmer_filter.hpp"
+#include "metrics.hpp"
+
+// Qué se necesita de cada secuencia.
+// - ALL: todas las posiciones.
+// - EXISTS: solo si cada patrón aparece; su búsqueda termina en la primera coincidencia.
+// - FIRST: las primeras 'limit' posiciones de cada patrón; su búsqueda termina al reunirlas.
+// - COUNT: cuántas coincidencias hay, sin guardar posiciones.
+// - TOP: las cuentas, para quedarse con los 'limit' sospechosos con más coincidencias.
+enum class QueryMode { ALL, EXISTS, COUNT, FIRST, TOP };
+
+struct Query {
+    QueryMode mode = QueryMode::ALL;
+    size_t limit = 0;
+
+    // Posiciones que se necesitan de cada patrón (SIZE_MAX = todas).
+    size_t positionLimit() const {
+        return mode == QueryMode::EXISTS ? 1 : mode == QueryMode::FIRST ? limit : SIZE_MAX;
+    }
+    bool countsOnly() const { return mode == QueryMode::COUNT || mode == QueryMode::TOP; }
+};
+
+// "all", "exists", "count", "first=N" o "top=K" (N y K positivos). Retorna false si no es válido.
+bool parseQuery(const std::string& text, Query& query);
+
+// Forma textual de la consulta, la misma que acepta parseQuery.
+std::string queryName(const Query& query);
+
+// Coincidencias de una o varias secuencias en formato CSR: las posiciones de todas las filas
+// van seguidas en un solo arreglo y offsets[r] indica dónde empieza la fila r (offsets tiene
+// una entrada más que filas). Cada secuencia ocupa patternCount() filas consecutivas, una por
+// patrón en el orden de searchPatterns(). Los buscadores agregan al final, de modo que la
+// misma tabla se reutiliza con clear() sin volver a reservar memoria.
+struct MatchTable {
+    std::vector<int64_t> positions;
+    // Solo en búsqueda aproximada: errores de cada posición (paralelo a 'positions').
+    std::vector<int> distances;
+    std::vector<size_t> offsets = {0};
+    // Solo en las consultas que cuentan (Query::countsOnly): coincidencias de cada fila, que
+    // no tiene posiciones.
+    std::vector<uint64_t> counts;
+    // Bases recorridas y contadores del algoritmo en esta búsqueda.
+    SearchCounters counters;
+
+    size_t rowCount() const { return offsets.size() - 1; }
+    size_t rowSize(size_t row) const { return offsets[row + 1] - offsets[row]; }
+    const int64_t* rowPositions(size_t row) const { return positions.data() + offsets[row]; }
+    // Solo si hasDistances().
+    const int* rowDistances(size_t row) const { return distances.data() + offsets[row]; }
+    bool hasDistances() const { return !distances.empty(); }
+    bool hasCounts() const { return !counts.empty(); }
+    // Coincidencias de la fila, tenga posiciones o solo su cuenta.
+    uint64_t rowMatches(size_t row) const { return hasCounts() ? counts[row] : rowSize(row); }
+
+    // Las posiciones agregadas desde la fila anterior forman una fila nueva.
+    void closeRow() { offsets.push_back(positions.size()); }
+    // Fila nueva sin posiciones, con solo su cuenta.
+    void closeRow(uint64_t count) {
+        offsets.push_back(positions.size());
+        counts.push_back(count);
+    }
+
+    void clear() {
+        positions.clear();
+        distances.clear();
+        offsets.assign(1, 0);
+        counts.clear();
+        counters = SearchCounters();
+    }
+};
+
+// Agrega al final de 'target' las filas de 'source' (secuencias posteriores).
+void appendRows(MatchTable& target, const MatchTable& source);
+
+// Agrega a las filas de 'target' las de 'segment', que es un tramo posterior de la misma
+// secuencia (ambas tablas tienen una sola secuencia de 'row_count' filas).
+void appendSegment(MatchTable& target, const MatchTable& segment, size_t row_count);
+
+// Consulta preparada: algoritmo + patrones, con sus estructuras (autómata, máscaras)
+// construidas una sola vez. Es de solo lectura durante la búsqueda, por lo que
+// varios hilos pueden compartir la misma instancia.
+class SearchEngine {
+public:
+    // max_errors solo se usa en las búsquedas aproximadas (ED, HD).
+    // Con both_strands también se busca el complemento reverso de cada patrón: las
+    // coincidencias del patrón p en la hebra opuesta quedan en el índice p + N (N = número
+    // de patrones entregados). KMP y RK buscan ambas orientaciones en el mismo recorrido
+    // del texto y AC construye un solo autómata con las dos.
+    // 'query' indica cuántas posiciones se necesitan: KMP, RK y AC dejan de recorrer el texto
+    // al reunirlas, o solo cuentan; el resto busca todas y recorta el resultado.
+    SearchEngine(const std::string& algorithm_name, const std::vector<std::string>& patterns, int max_errors = 0,
+                 bool both_strands = false, const Query& query = Query());
+
+    // Indica si el nombre corresponde a un algoritmo soportado (KMP, RK, AC, BP, ED, HD, FM, SIMD).
+    static bool isValidAlgorithm(const std::string& algorithm_name);
+
+    // BP, ED y HD trabajan sobre secuencias empaquetadas; el resto sobre texto.
+    bool usesPackedInput() const { return algorithm == "BP" || isApproximate(); }
+
+    // FM consulta el índice guardado junto al CSV en lugar de recorrer las secuencias.
+    bool usesIndex() const { return algorithm == "FM"; }
+
+    // ED (distancia de edición) y HD (distancia de Hamming) admiten errores.
+    bool isApproximate() const { return algorithm == "ED" || algorithm == "HD"; }
+
+    bool bothStrands() const { return both_strands; }
+
+    // El prefiltro de k-mers solo sirve en las búsquedas exactas sobre el texto completo
+    // (KMP, RK, AC, SIMD, BP) y si todos los patrones tienen al menos KMER_LENGTH bases:
+    // un patrón más corto podría aparecer en cualquier secuencia.
+    bool usesKmerFilter() const { return !kmer_hashes.empty(); }
+
+    // Indica si algún patrón puede aparecer en la secuencia 'suspect' según el prefiltro.
+    // Los complementos reversos tienen los mismos k-mers canónicos que su patrón.
+    bool passesKmerFilter(const KmerFilter& filter, size_t suspect) const;
+
+    // Agrega las filas vacías (sin posiciones, o con cuenta 0) de una secuencia que no se
+    // recorre porque el prefiltro la descartó.
+    void skipRange(MatchTable& matches) const;
+
+    // Posiciones que se guardan por patrón (SIZE_MAX = todas) y si solo se cuentan.
+    size_t positionLimit() const { return position_limit; }
+    bool countsOnly() const { return counts_only; }
+
+    // Indica si las filas de la secuencia que empiezan en 'first_row' ya tienen todas las
+    // posiciones que pide la consulta, así que el resto de la secuencia (los fragmentos
+    // siguientes) no cambiaría el resultado.
+    bool hasEnoughMatches(const MatchTable& matches, size_t first_row) const;
+
+    // Patrones buscados, incluidos los complementos reversos con both_strands.
+    const std::vector<std::string>& searchPatterns() const { return patterns; }
+    size_t patternCount() const { return patterns.size(); }
+    size_t maxPatternLength() const { return max_pattern_length; }
+
+    // Bases que searchRange lee antes de begin (los errores permitidos en la distancia de
+    // edición) y después de end. Quien divide una secuencia en fragmentos debe repetirlas.
+    size_t contextBefore() const { return algorithm == "ED" ? max_errors : 0; }
+    size_t contextAfter() const { return max_pattern_length > 0 ? max_pattern_length - 1 : 0; }
+
+    // Busca todos los patrones y agrega a 'matches' una fila por patrón con las coincidencias
+    // que comienzan en [begin, end). Se leen hasta maxPatternLength() - 1 bases más allá de
+    // end para no perder las coincidencias que cruzan el límite; las posiciones son absolutas.
+    // Si la consulta solo cuenta, cada fila lleva la cuenta en lugar de las posiciones.
+    void searchRange(std::string_view text, size_t begin, size_t end, MatchTable& matches) const;
+    void searchRange(const PackedSequence& text, size_t begin, size_t end, MatchTable& matches) const;
+
+private:
+    std::string algorithm;
+    std::vector<std::string> patterns;
+    size_t max_pattern_length = 0;
+    size_t max_errors = 0;
+    bool both_strands = false;
+    size_t position_limit = SIZE_MAX;
+    bool counts_only = false;
+    std::vector<std::vector<int>> kmp_tables; // tabla LPS de cada patrón (KMP)
+    std::unique_ptr<AhoCorasickAutomaton> automaton;
+    std::vector<BitParallelMatcher> bit_parallel_matchers;
+    std::vector<ApproximateMatcher> approximate_matchers;
+    std::vector<std::vector<uint64_t>> kmer_hashes; // huellas de los k-mers de cada patrón (prefiltro)
+
+    void countRange(std::string_view text, size_t begin, size_t end, MatchTable& matches) const;
+    void finishRow(MatchTable& matches, size_t shift, size_t end) const;
+};
+
+#endif
@@ -0,0 +1,569 @@
+#include "search_service.hpp"
+#include "search_engine.hpp"
+#include "parallel_search.hpp"
+#include "sequence_stream.hpp"
+#include "stream_pipeline.hpp"
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include <limits>
+
+static SearchOutcome failure(const std::string& message) {
+    SearchOutcome outcome;
+    outcome.success = false;
+    outcome.message = message;
+    return outcome;
+}
+
+static SearchOutcome succeed(SearchOutcome& outcome, SearchMetrics& metrics, const std::string& algorithm_name) {
+    metrics.peak_rss_bytes = peakResidentBytes();
+    outcome.metrics = metrics;
+    outcome.success = true;
+    outcome.message = "Búsqueda exitosa con " + algorithm_name + 
+                      ". Se encontraron coincidencias en " + 
+                      std::to_string(outcome.suspect_count) + " sospechoso(s).";
+    return std::move(outcome);
+}
+
+static int bestDistance(const std::vector<int>& distances) {
+    int best = distances.empty() ? -1 : distances[0];
+    for (int distance : distances) {
+        if (distance < best) {
+            best = distance;
+        }
+    }
+    return best;
+}
+
+// Entero decimal no negativo de a lo sumo 18 cifras (cabe en 64 bits).
+static bool isByteOffset(const std::string& value) {
+    return !value.empty() && value.size() <= 18 && value.find_first_not_of("0123456789") == std::string::npos;
+}
+
+bool parseByteRange(const std::string& text, SearchOptions& options) {
+    const size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    const std::string begin = text.substr(0, colon);
+    const std::string end = text.substr(colon + 1);
+    if (!isByteOffset(begin) || !isByteOffset(end)) {
+        return false;
+    }
+    options.range_begin = std::stoull(begin);
+    options.range_end = std::stoull(end);
+    return options.range_begin < options.range_end;
+}
+
+bool parseCount(const std::string& value, size_t& count) {
+    if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    count = std::stoul(value);
+    return true;
+}
+
+size_t parseSize(const std::string& value) {
+    const size_t digits = std::min(value.find_first_not_of("0123456789"), value.size());
+    if (digits == 0 || digits > 18) {
+        return 0;
+    }
+    uint64_t multiplier = 1;
+    if (digits != value.size()) {
+        if (digits + 1 != value.size()) {
+            return 0;
+        }
+        switch (value[digits]) {
+            case 'K': case 'k': multiplier = uint64_t(1) << 10; break;
+            case 'M': case 'm': multiplier = uint64_t(1) << 20; break;
+            case 'G': case 'g': multiplier = uint64_t(1) << 30; break;
+            default: return 0;
+        }
+    }
+    const uint64_t number = std::stoull(value.substr(0, digits));
+    if (number > std::numeric_limits<size_t>::max() / multiplier) {
+        return 0;
+    }
+    return static_cast<size_t>(number * multiplier);
+}
+
+// Consulta cada patrón en el índice FM y arma la tabla de coincidencias de todos los
+// sospechosos, con la misma forma que el resultado de searchSuspects.
+static MatchTable searchIndex(const FMIndex& index, const std::vector<std::string>& patterns) {
+    std::vector<std::vector<std::vector<int64_t>>> located(patterns.size());
+    for (size_t p = 0; p < patterns.size(); ++p) {
+        index.locate(patterns[p], located[p]);
+    }
+    MatchTable matches;
+    for (size_t s = 0; s < index.suspectCount(); ++s) {
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            if (s < located[p].size()) {
+                matches.positions.insert(matches.positions.end(), located[p][s].begin(), located[p][s].end());
+            }
+            matches.closeRow();
+        }
+    }
+    return matches;
+}
+
+// Copia en 'positions' (y en 'distances' en la búsqueda aproximada) las primeras 'limit'
+// coincidencias de la fila 'row'. Con ambas hebras se mezclan en orden de posición con las de
+// su complemento reverso ('reverse_row') y se anota la hebra de cada una; si el patrón es su
+// propio complemento reverso las dos filas son iguales y solo se conserva la directa. Los
+// vectores se reutilizan entre sospechosos.
+static void collectHits(const MatchTable& matches, size_t row, size_t reverse_row, bool both_strands, bool palindrome,
+                        size_t limit, std::vector<int64_t>& positions, std::vector<int>& distances,
+                        std::vector<char>& strands) {
+    positions.clear();
+    distances.clear();
+    strands.clear();
+    const bool with_distances = matches.hasDistances();
+    const int64_t* forward_positions = matches.rowPositions(row);
+    const size_t forward_count = std::min(matches.rowSize(row), limit);
+    if (!both_strands || palindrome) {
+        positions.assign(forward_positions, forward_positions + forward_count);
+        if (with_distances) {
+            distances.assign(matches.rowDistances(row), matches.rowDistances(row) + forward_count);
+        }
+        if (both_strands) {
+            strands.assign(forward_count, '+');
+        }
+        return;
+    }
+
+    const int64_t* reverse_positions = matches.rowPositions(reverse_row);
+    const size_t reverse_count = std::min(matches.rowSize(reverse_row), limit);
+    size_t f = 0;
+    size_t r = 0;
+    while ((f < forward_count || r < reverse_count) && positions.size() < limit) {
+        const bool forward = r == reverse_count || (f < forward_count && forward_positions[f] <= reverse_positions[r]);
+        if (forward) {
+            positions.push_back(forward_positions[f]);
+            if (with_distances) distances.push_back(matches.rowDistances(row)[f]);
+            strands.push_back('+');
+            ++f;
+        } else {
+            positions.push_back(reverse_positions[r]);
+            if (with_distances) distances.push_back(matches.rowDistances(reverse_row)[r]);
+            strands.push_back('-');
+            ++r;
+        }
+    }
+}
+
+// Convierte las filas de cada sospechoso en su resultado (agrupado por marcador en modo
+// panel, o una sola lista de posiciones con un único patrón) y lo entrega al sink, lo
+// guarda en outcome.results, o ambas cosas si la caché de resultados lo necesita. En la
+// consulta top solo conserva los mejores hasta finish().
+class ResultCollector {
+public:
+    ResultCollector(const SearchEngine& engine, const PatternList& panel, bool panel_mode, const Query& query,
+                    SearchOutcome& outcome, ResultSink* sink, bool keep_results)
+        : engine(engine), panel(panel), panel_mode(panel_mode), outcome(outcome), sink(sink),
+          keep_results(keep_results), top_limit(query.mode == QueryMode::TOP ? query.limit : 0) {
+        if (engine.bothStrands()) {
+            for (const auto& entry : panel) {
+                palindromes.push_back(reverseComplement(entry.second) == entry.second);
+            }
+        } else {
+            palindromes.assign(panel.size(), false);
+        }
+    }
+
+    // Tiempo pasado en el sink, que no es parte de la búsqueda.
+    long long sink_ns = 0;
+
+    // Las filas del sospechoso empiezan en 'first_row'. Los que no tuvieron coincidencias se omiten.
+    void add(std::string_view name, const MatchTable& matches, size_t first_row) {
+        if (!fillEntry(name, matches, first_row)) {
+            return;
+        }
+        if (top_limit > 0) {
+            rank();
+            return;
+        }
+        deliver();
+    }
+
+    // Entrega los sospechosos de la consulta top, de más a menos coincidencias (en un empate,
+    // en el orden del CSV).
+    void finish() {
+        std::sort_heap(ranking.begin(), ranking.end(), ranksBefore);
+        for (RankedEntry& ranked : ranking) {
+            std::swap(entry, ranked.entry);
+            deliver();
+        }
+        ranking.clear();
+    }
+
+private:
+    struct RankedEntry {
+        size_t order; // posición del sospechoso en el CSV, para desempatar
+        ResultEntry entry;
+    };
+
+    const SearchEngine& engine;
+    const PatternList& panel;
+    bool panel_mode;
+    SearchOutcome& outcome;
+    ResultSink* sink;
+    bool keep_results;
+    std::vector<char> palindromes;
+    ResultEntry entry; // se reutiliza entre sospechosos
+    // Consulta top: montículo con los 'top_limit' mejores hasta ahora, con el peor en la raíz.
+    size_t top_limit;
+    size_t ranked_count = 0;
+    std::vector<RankedEntry> ranking;
+
+    static bool ranksBefore(const RankedEntry& a, const RankedEntry& b) {
+        return a.entry.matches != b.entry.matches ? a.entry.matches > b.entry.matches : a.order < b.order;
+    }
+
+    // Ofrece 'entry' al montículo. Los sospechosos llegan en el orden del CSV, así que uno
+    // nuevo solo desplaza al peor si tiene más coincidencias.
+    void rank() {
+        const size_t order = ranked_count++;
+        if (ranking.size() < top_limit) {
+            ranking.push_back({order, ResultEntry()});
+            std::swap(ranking.back().entry, entry);
+            std::push_heap(ranking.begin(), ranking.end(), ranksBefore);
+        } else if (entry.matches > ranking.front().entry.matches) {
+            std::pop_heap(ranking.begin(), ranking.end(), ranksBefore);
+            ranking.back().order = order;
+            std::swap(ranking.back().entry, entry);
+            std::push_heap(ranking.begin(), ranking.end(), ranksBefore);
+        }
+    }
+
+    void deliver() {
+        ++outcome.suspect_count;
+        if (sink) {
+            PhaseTimer sink_timer;
+            sink->write(entry);
+            sink_ns += sink_timer.elapsedNs();
+        }
+        if (keep_results) {
+            if (sink) {
+                outcome.results.push_back(entry);
+            } else {
+                outcome.results.push_back(std::move(entry));
+            }
+        }
+    }
+
+    // Coincidencias del patrón en una consulta que solo cuenta: las de su fila más las de su
+    // complemento reverso (salvo si es su propio complemento, cuyas filas son iguales).
+    static uint64_t countHits(const MatchTable& matches, size_t row, size_t reverse_row, bool both_strands,
+                              bool palindrome) {
+        return matches.rowMatches(row) + (both_strands && !palindrome ? matches.rowMatches(reverse_row) : 0);
+    }
+
+    bool fillEntry(std::string_view name, const MatchTable& matches, size_t first_row) {
+        const size_t count = panel.size();
+        const bool both_strands = engine.bothStrands();
+        entry.name.assign(name.data(), name.size());
+        entry.matches = 0;
+        entry.best_distance = -1;
+        entry.similarity = 0.0;
+
+        if (panel_mode) {
+            entry.positions.clear();
+            entry.distances.clear();
+            entry.strands.clear();
+            size_t used = 0;
+            for (size_t p = 0; p < count; ++p) {
+                const size_t row = first_row + p;
+                const size_t reverse_row = first_row + count + p;
+                if (matches.rowMatches(row) == 0 && (!both_strands || matches.rowMatches(reverse_row) == 0)) {
+                    continue;
+                }
+                if (used == entry.pattern_hits.size()) {
+                    entry.pattern_hits.emplace_back();
+                }
+                PatternHits& hits = entry.pattern_hits[used++];
+                hits.marker = panel[p].first;
+                hits.pattern = panel[p].second;
+                hits.best_distance = -1;
+                hits.similarity = 0.0;
+                if (engine.countsOnly()) {
+                    hits.positions.clear();
+                    hits.distances.clear();
+                    hits.strands.clear();
+                    hits.matches = countHits(matches, row, reverse_row, both_strands, palindromes[p]);
+                } else {
+                    collectHits(matches, row, reverse_row, both_strands, palindromes[p], engine.positionLimit(),
+                                hits.positions, hits.distances, hits.strands);
+                    hits.matches = hits.positions.size();
+                    if (engine.isApproximate()) {
+                        hits.best_distance = bestDistance(hits.distances);
+                        hits.similarity = similarityPercent(hits.best_distance, panel[p].second.length());
+                    }
+                }
+                entry.matches += hits.matches;
+            }
+            entry.pattern_hits.resize(used);
+        } else {
+            entry.pattern_hits.clear();
+            if (engine.countsOnly()) {
+                entry.positions.clear();
+                entry.distances.clear();
+                entry.strands.clear();
+                entry.matches = countHits(matches, first_row, first_row + 1, both_strands, palindromes[0]);
+                return entry.matches > 0;
+            }
+            collectHits(matches, first_row, first_row + 1, both_strands, palindromes[0], engine.positionLimit(),
+                        entry.positions, entry.distances, entry.strands);
+            entry.matches = entry.positions.size();
+            if (engine.isApproximate() && entry.matches > 0) {
+                entry.best_distance = bestDistance(entry.distances);
+                entry.similarity = similarityPercent(entry.best_distance, panel[0].second.length());
+            }
+        }
+        return entry.matches > 0;
+    }
+};
+
+// Recorre el archivo por fragmentos con la tubería lector -> buscadores -> escritor
+// (runStreamPipeline), de modo que la memoria depende del tamaño de fragmento y no del
+// archivo. Cada fragmento repite el contexto que el buscador lee alrededor de su rango, así
+// que las coincidencias que cruzan el límite entre fragmentos se encuentran una sola vez. Las
+// coincidencias de los fragmentos de un registro se unen aquí, en el orden del archivo; si
+// la consulta ya tiene todas las posiciones que pide del registro, el resto de sus
+// fragmentos no se busca.
+static bool searchStream(const SearchRequest& request, const SearchEngine& engine, ResultCollector& collector,
+                         SearchMetrics& metrics) {
+    MatchTable record_matches;
+    auto emit = [&](PipelineChunk& chunk) {
+        if (!engine.hasEnoughMatches(record_matches, 0)) {
+            if (record_matches.rowCount() == 0) {
+                std::swap(record_matches, chunk.matches);
+            } else {
+                appendSegment(record_matches, chunk.matches, engine.patternCount());
+            }
+        } else {
+            // Se buscó antes de que el escritor supiera que no hacía falta.
+            metrics.counters.add(chunk.matches.counters);
+        }
+        const bool enough = engine.hasEnoughMatches(record_matches, 0);
+        if (chunk.last) {
+            metrics.counters.add(record_matches.counters);
+            collector.add(chunk.name, record_matches, 0);
+            record_matches.clear();
+        }
+        return enough;
+    };
+    return runStreamPipeline(request.csv_path, engine, request.options.chunk_size,
+                             resolveThreadCount(request.options.threads), request.options.pipeline_depth, emit,
+                             metrics);
+}
+
+// Descripción normalizada de todo lo que determina el resultado (clave de la caché). Los
+// textos llevan su longitud delante para que ningún marcador pueda imitar a otro campo.
+static std::string describeRequest(const std::string& algorithm_name, const PatternList& panel, bool panel_mode,
+                                   const SearchOptions& options) {
+    std::string description = "algorithm=" + algorithm_name +
+                              "\nmax_errors=" + std::to_string(options.max_errors) +
+                              "\nboth_strands=" + (options.both_strands ? "1" : "0") +
+                              "\nmode=" + (panel_mode ? "panel" : "single") +
+                              "\nquery=" + queryName(options.query) + "\n";
+    for (const auto& entry : panel) {
+        description += std::to_string(entry.first.size()) + ":" + entry.first + " " +
+                       std::to_string(entry.second.size()) + ":" + entry.second + "\n";
+    }
+    return description;
+}
+
+// Guarda el resultado de una búsqueda completa en la caché de resultados, si está activa.
+static void storeResult(const ResultCache* result_cache, const ResultCacheKey& key, const SearchOutcome& outcome,
+                        SearchMetrics& metrics) {
+    if (result_cache) {
+        PhaseTimer store_timer;
+        result_cache->store(key, outcome.results);
+        metrics.cache_ns += store_timer.elapsedNs();
+    }
+}
+
+SearchOutcome runSearch(const SearchRequest& request, DatasetCache* cache, ResultSink* sink) {
+    const std::string& algorithm_name = request.algorithm;
+
+    if (!SearchEngine::isValidAlgorithm(algorithm_name)) {
+        std::cerr << "ERROR: Algoritmo no reconocido: " << algorithm_name << std::endl;
+        return failure("Algoritmo no reconocido.");
+    }
+
+    SearchMetrics metrics;
+
+    // Modo panel: "@ruta" carga un archivo con varios marcadores que se buscan en una sola pasada
+    PatternList panel = request.panel;
+    const bool panel_mode = !panel.empty() || (!request.pattern.empty() && request.pattern[0] == '@');
+    if (panel.empty()) {
+        // Validación básica del patrón
+        if (request.pattern.empty()) {
+            return failure("El patrón de ADN no puede estar vacío.");
+        }
+        if (panel_mode) {
+            PhaseTimer panel_timer;
+            if (!readPatternPanel(request.pattern.substr(1), panel)) {
+                return failure("Fallo al leer el archivo de patrones.");
+            }
+            metrics.load_ns += panel_timer.elapsedNs();
+        } else {
+            panel.push_back({request.pattern, request.pattern});
+        }
+    }
+
+    std::vector<std::string> patterns;
+    for (const auto& entry : panel) {
+        patterns.push_back(entry.second);
+    }
+
+    // Los buscadores (autómata, máscaras) se construyen una sola vez para todos los sospechosos
+    PhaseTimer preprocess_timer;
+    const SearchEngine engine(algorithm_name, patterns, request.options.max_errors, request.options.both_strands,
+                              request.options.query);
+    metrics.preprocess_ns = preprocess_timer.elapsedNs();
+
+    if (request.options.max_errors != 0 && !engine.isApproximate()) {
+        return failure("max_errors solo se admite con los algoritmos aproximados ED y HD.");
+    }
+    if (engine.isApproximate()) {
+        for (const auto& current_pattern : patterns) {
+            if (request.options.max_errors < 0 || static_cast<size_t>(request.options.max_errors) >= current_pattern.length()) {
+                return failure("max_errors debe ser menor que la longitud de cada patrón.");
+            }
+        }
+    }
+
+    SearchOutcome outcome;
+
+    // FASTA, FASTQ y CSV con options.stream: lectura por fragmentos, sin cargar el archivo.
+    const bool streaming = request.csv_data.empty() &&
+                           (request.options.stream || detectSequenceFormat(request.csv_path) != SequenceFormat::CSV);
+    if (streaming && engine.usesIndex()) {
+        return failure("FM consulta el índice de un CSV completo; no admite lectura por fragmentos ni FASTA/FASTQ.");
+    }
+    const bool ranged = request.options.range_end != 0;
+    if (ranged && (streaming || engine.usesIndex() || !request.csv_data.empty())) {
+        return failure("Un rango de bytes solo se admite sobre un CSV en disco, sin lectura por fragmentos y sin FM.");
+    }
+
+    // Caché de resultados: si la misma búsqueda ya se hizo sobre el mismo contenido, se
+    // devuelve el resultado guardado sin cargar ni recorrer el archivo.
+    std::unique_ptr<ResultCache> result_cache;
+    ResultCacheKey cache_key;
+    if (!request.options.result_cache_dir.empty() && !ranged) {
+        PhaseTimer cache_timer;
+        bool hashed = true;
+        if (!request.csv_data.empty()) {
+            cache_key.content_hash = hashBytes(request.csv_data.data(), request.csv_data.size());
+            cache_key.content_size = request.csv_data.size();
+        } else {
+            // Si el archivo no se puede leer, la carga informará el error.
+            hashed = hashInputFile(request.csv_path, cache_key.content_hash, cache_key.content_size);
+        }
+        if (hashed) {
+            cache_key.request = describeRequest(algorithm_name, panel, panel_mode, request.options);
+            result_cache.reset(new ResultCache(request.options.result_cache_dir, request.options.result_cache_limit));
+            if (result_cache->load(cache_key, outcome.results)) {
+                metrics.cache_ns = cache_timer.elapsedNs();
+                metrics.result_cache_hits = 1;
+                outcome.duration_ms = metrics.cache_ns / 1000000;
+                outcome.suspect_count = outcome.results.size();
+                if (sink) {
+                    PhaseTimer sink_timer;
+                    for (const ResultEntry& entry : outcome.results) {
+                        sink->write(entry);
+                    }
+                    metrics.serialize_ns = sink_timer.elapsedNs();
+                    outcome.results.clear();
+                }
+                return succeed(outcome, metrics, algorithm_name);
+            }
+            metrics.result_cache_misses = 1;
+        }
+        metrics.cache_ns = cache_timer.elapsedNs();
+    }
+
+    // Con un sink los resultados solo se guardan si la caché de resultados los necesita.
+    ResultCollector collector(engine, panel, panel_mode, request.options.query, outcome, sink,
+                              sink == nullptr || result_cache != nullptr);
+
+    if (streaming) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        if (!searchStream(request, engine, collector, metrics)) {
+            return failure("Fallo al leer el archivo de secuencias.");
+        }
+        collector.finish();
+        auto end_time = std::chrono::high_resolution_clock::now();
+        outcome.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+        metrics.serialize_ns = collector.sink_ns;
+        storeResult(result_cache.get(), cache_key, outcome, metrics);
+        if (sink) {
+            outcome.results.clear();
+        }
+        return succeed(outcome, metrics, algorithm_name);
+    }
+
+    // Cargar Datos del CSV
+    // BP trabaja directamente sobre las secuencias empaquetadas a 2 bits por base y FM
+    // sobre el índice guardado junto al CSV (se construye en la primera consulta), igual
+    // que el prefiltro de k-mers.
+    const DatasetFormat format = engine.usesIndex() ? DatasetFormat::Index
+                               : engine.usesPackedInput() ? DatasetFormat::Packed : DatasetFormat::Text;
+    const bool with_kmer_filter = request.options.kmer_filter && engine.usesKmerFilter() && !ranged;
+    PhaseTimer load_timer;
+    std::shared_ptr<const Dataset> dataset =
+        !request.csv_data.empty() ? loadDatasetFromMemory(request.csv_data, format, with_kmer_filter)
+        : ranged ? loadDatasetRange(request.csv_path, request.options.range_begin, request.options.range_end, format)
+        : cache ? cache->get(request.csv_path, format, with_kmer_filter)
+                : loadDataset(request.csv_path, format, with_kmer_filter);
+    metrics.load_ns += load_timer.elapsedNs();
+    if (!dataset) {
+        return failure("Fallo al leer o validar el archivo CSV.");
+    }
+    const KmerFilter* kmer_filter = with_kmer_filter ? &dataset->kmer_filter : nullptr;
+
+    // Ejecución de la Búsqueda y Medición de Rendimiento
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Cada sospechoso se convierte en resultado (y se escribe, con un sink) en cuanto están
+    // listos todos los anteriores, en el orden del CSV.
+    const size_t rows_per_suspect = engine.patternCount();
+    auto consume = [&](size_t first_suspect, const MatchTable& matches) {
+        metrics.counters.add(matches.counters);
+        for (size_t row = 0; row < matches.rowCount(); row += rows_per_suspect) {
+            const size_t s = first_suspect + row / rows_per_suspect;
+            const std::string_view name = engine.usesIndex() ? dataset->fm_index.suspectName(s)
+                                        : engine.usesPackedInput() ? std::string_view(dataset->packed_suspects[s].name)
+                                                                   : dataset->suspects.records[s].name;
+            collector.add(name, matches, row);
+        }
+    };
+
+    const unsigned threads = resolveThreadCount(request.options.threads);
+    size_t suspects_processed = 0;
+    if (engine.usesIndex()) {
+        consume(0, searchIndex(dataset->fm_index, engine.searchPatterns()));
+        suspects_processed = dataset->fm_index.suspectCount();
+    } else if (engine.usesPackedInput()) {
+        searchSuspects(engine, dataset->packed_suspects, threads, consume, kmer_filter);
+        suspects_processed = dataset->packed_suspects.size();
+    } else {
+        searchSuspects(engine, dataset->suspects.records, threads, consume, kmer_filter);
+        suspects_processed = dataset->suspects.records.size();
+    }
+    collector.finish();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    outcome.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    metrics.search_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count() -
+                        collector.sink_ns;
+    metrics.serialize_ns = collector.sink_ns;
+    metrics.counters.suspects_processed = suspects_processed;
+    storeResult(result_cache.get(), cache_key, outcome, metrics);
+    if (sink) {
+        outcome.results.clear();
+    }
+    return succeed(outcome, metrics, algorithm_name);
+}
@@ -0,0 +1,82 @@
+#ifndef SEARCH_SERVICE_HPP
+#define SEARCH_SERVICE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "csv_reader.hpp"
+#include "dataset_cache.hpp"
+#include "json_output.hpp"
+#include "metrics.hpp"
+#include "result_cache.hpp"
+#include "result_writer.hpp"
+#include "search_engine.hpp"
+
+// Opciones de ejecución de una búsqueda (línea de comandos o petición al servidor)
+struct SearchOptions {
+    unsigned threads = 1; // 0 = todos los núcleos
+    int max_errors = 0;   // errores permitidos en la búsqueda aproximada (ED, HD)
+    bool both_strands = false; // buscar también el complemento reverso de cada patrón
+    // Lectura por fragmentos (SequenceStream): la memoria depende de chunk_size y no del
+    // tamaño del archivo. Los FASTA y FASTQ siempre se leen así; los CSV solo si stream = true.
+    bool stream = false;
+    size_t chunk_size = 0; // bases por fragmento (0 = DEFAULT_STREAM_CHUNK)
+    // Lotes de fragmentos en curso entre la lectura, la búsqueda y la escritura (0 =
+    // PIPELINE_BATCHES_PER_THREAD por hilo + 2): más lotes toleran etapas más desparejas a
+    // cambio de memoria.
+    size_t pipeline_depth = 0;
+    // Carpeta de la caché de resultados (vacía = sin caché) y su tamaño máximo en bytes.
+    std::string result_cache_dir;
+    uint64_t result_cache_limit = DEFAULT_RESULT_CACHE_LIMIT;
+    // Qué se necesita de cada sospechoso (todas las posiciones, si aparece, cuántas veces...).
+    Query query;
+    // Prefiltro de k-mers (KmerFilter): descarta sin recorrerlas las secuencias en las que
+    // ningún patrón puede aparecer. Se guarda junto al CSV la primera vez. No cambia el resultado.
+    bool kmer_filter = false;
+    // Solo los registros del rango de bytes [range_begin, range_end) del CSV, que empieza al
+    // inicio de un registro: un fragmento del modo coordinador (range_end = 0: todo el archivo).
+    // Con un rango no se usan la caché de resultados ni el prefiltro de k-mers.
+    uint64_t range_begin = 0;
+    uint64_t range_end = 0;
+};
+
+// "B:E" con B < E (bytes del CSV) en range_begin y range_end. Retorna false si no es válido.
+bool parseByteRange(const std::string& text, SearchOptions& options);
+
+// Entero no negativo de a lo sumo 9 cifras (cabe en un int). Retorna false si no es válido.
+bool parseCount(const std::string& value, size_t& count);
+
+// Tamaño positivo con sufijo opcional K, M o G (potencias de 1024). Devuelve 0 si no es
+// válido, es 0 o no cabe en size_t.
+size_t parseSize(const std::string& value);
+
+// Petición de búsqueda completa
+struct SearchRequest {
+    std::string csv_path;
+    std::string_view csv_data; // contenido del CSV ya en memoria; si no está vacío se usa en lugar de csv_path
+    std::string pattern;   // patrón único, o "@archivo" con un panel de marcadores
+    PatternList panel;     // panel ya cargado; si no está vacío tiene prioridad sobre 'pattern'
+    std::string algorithm;
+    SearchOptions options;
+};
+
+// Resultado de una búsqueda, listo para serializar en JSON
+struct SearchOutcome {
+    bool success = false;
+    std::string message;
+    std::vector<ResultEntry> results; // vacío si los sospechosos se entregaron a un ResultSink
+    size_t suspect_count = 0;         // sospechosos con coincidencias
+    long long duration_ms = 0;
+    SearchMetrics metrics; // serialize_ns lo completa quien escribe el JSON
+};
+
+// Ejecuta la búsqueda completa: valida la petición, carga el CSV (o lo toma de la
+// caché si se entrega una) y busca en todos los sospechosos. Los archivos FASTA/FASTQ,
+// y los CSV con options.stream, se recorren por fragmentos sin cargarlos completos.
+// Si se entrega 'sink', cada sospechoso con coincidencias se le entrega en el orden del CSV
+// en cuanto termina su búsqueda, y outcome.results queda vacío: la memoria usada no crece
+// con el número de coincidencias ya escritas.
+SearchOutcome runSearch(const SearchRequest& request, DatasetCache* cache = nullptr, ResultSink* sink = nullptr);
+
+#endif
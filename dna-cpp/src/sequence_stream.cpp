@@ -0,0 +1,345 @@
+#include "sequence_stream.hpp"
+#include "mapped_csv.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+// Caracteres que cortan un tramo de bases: fin de línea en FASTA/FASTQ, y además la coma
+// (y la comilla de cierre si la secuencia va entre comillas) en el CSV.
+struct StopTable {
+    std::array<unsigned char, 256> line;
+    std::array<unsigned char, 256> field;
+    std::array<unsigned char, 256> quoted_field;
+
+    StopTable() {
+        line.fill(0);
+        line['\n'] = line['\r'] = 1;
+        field = line;
+        field[','] = 1;
+        quoted_field = field;
+        quoted_field['"'] = 1;
+    }
+};
+
+static const StopTable STOPS;
+
+SequenceFormat detectSequenceFormat(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".fa" || extension == ".fasta" || extension == ".fna") {
+        return SequenceFormat::FASTA;
+    }
+    if (extension == ".fq" || extension == ".fastq") {
+        return SequenceFormat::FASTQ;
+    }
+    if (extension == ".csv") {
+        return SequenceFormat::CSV;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return SequenceFormat::CSV; // el error se informa al abrirlo para leer
+    }
+    int first = std::fgetc(file);
+    std::fclose(file);
+    if (first == '>') {
+        return SequenceFormat::FASTA;
+    }
+    return first == '@' ? SequenceFormat::FASTQ : SequenceFormat::CSV;
+}
+
+SequenceStream::SequenceStream(size_t chunk_bases, size_t overlap)
+    : chunk_bases(std::max(chunk_bases == 0 ? DEFAULT_STREAM_CHUNK : chunk_bases, overlap)), overlap(overlap) {}
+
+SequenceStream::~SequenceStream() {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+bool SequenceStream::open(const std::string& path, SequenceFormat input_format) {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        std::cerr << "ERROR: No se pudo abrir el archivo de secuencias en la ruta: " << path << std::endl;
+        return false;
+    }
+    format = input_format;
+    block.resize(STREAM_READ_BLOCK);
+    block_pos = 0;
+    block_length = 0;
+    line_start = true;
+    bases.clear();
+    bases.reserve(chunk_bases + overlap);
+    in_record = false;
+    record_count = 0;
+    invalid_sequences = 0;
+    read_error = false;
+
+    // Omitir la línea de cabecera (Nombre,Cadena_ADN)
+    if (format == SequenceFormat::CSV) {
+        skipLine();
+    }
+    return true;
+}
+
+bool SequenceStream::refill() {
+    if (file == nullptr) {
+        return false;
+    }
+    block_length = std::fread(block.data(), 1, block.size(), file);
+    block_pos = 0;
+    if (block_length == 0 && std::ferror(file)) {
+        std::cerr << "ERROR: Falló la lectura del archivo de secuencias." << std::endl;
+        read_error = true;
+    }
+    return block_length > 0;
+}
+
+int SequenceStream::peekByte() {
+    if (block_pos == block_length && !refill()) {
+        return -1;
+    }
+    return static_cast<unsigned char>(block[block_pos]);
+}
+
+int SequenceStream::getByte() {
+    int c = peekByte();
+    if (c != -1) {
+        ++block_pos;
+        line_start = c == '\n';
+    }
+    return c;
+}
+
+// Avanza hasta después del siguiente '\n' y devuelve la longitud de la línea sin el fin de línea.
+uint64_t SequenceStream::skipLine() {
+    uint64_t length = 0;
+    bool carriage_return = false;
+    while (block_pos < block_length || refill()) {
+        const char* begin = block.data() + block_pos;
+        const size_t available = block_length - block_pos;
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', available));
+        const size_t span = newline ? newline - begin : available;
+        if (span > 0) {
+            length += span;
+            carriage_return = begin[span - 1] == '\r';
+        }
+        block_pos += span;
+        if (newline) {
+            ++block_pos;
+            line_start = true;
+            break;
+        }
+    }
+    return carriage_return ? length - 1 : length;
+}
+
+// FASTA/FASTQ: el nombre es la primera palabra de la cabecera, sin el '>' o '@' inicial.
+void SequenceStream::readHeaderName() {
+    name.clear();
+    for (int c = getByte(); c != -1 && c != '\n'; c = getByte()) {
+        name.push_back(static_cast<char>(c));
+    }
+    size_t name_end = name.find_first_of(" \t\r");
+    if (name_end != std::string::npos) {
+        name.resize(name_end);
+    }
+}
+
+bool SequenceStream::beginRecord() {
+    quoted_sequence = false;
+
+    if (format != SequenceFormat::CSV) {
+        const int marker = format == SequenceFormat::FASTA ? '>' : '@';
+        // Se omiten las líneas vacías o cualquier texto antes de la siguiente cabecera.
+        while (true) {
+            int c = peekByte();
+            if (c == -1) {
+                return false;
+            }
+            if (line_start && c == marker) {
+                getByte();
+                readHeaderName();
+                return true;
+            }
+            skipLine();
+        }
+    }
+
+    while (true) {
+        int c = peekByte();
+        if (c == -1) {
+            return false;
+        }
+        name.clear();
+        if (c == '"') {
+            // Nombre entre comillas: puede contener comas y comillas escapadas ("").
+            getByte();
+            while ((c = getByte()) != -1) {
+                if (c == '"') {
+                    if (peekByte() != '"') break;
+                    getByte();
+                }
+                name.push_back(static_cast<char>(c));
+            }
+            while (c != -1 && c != ',' && c != '\n') {
+                c = getByte();
+            }
+        } else {
+            for (c = getByte(); c != -1 && c != ',' && c != '\n'; c = getByte()) {
+                name.push_back(static_cast<char>(c));
+            }
+        }
+        if (c != ',') {
+            continue; // fila sin secuencia
+        }
+
+        if (peekByte() == '"') {
+            getByte();
+            quoted_sequence = true;
+        }
+        // Las filas con la secuencia vacía se omiten, igual que en loadMappedCSV.
+        c = peekByte();
+        if (c == -1 || c == '\n' || c == '\r' || c == ',' || (quoted_sequence && c == '"')) {
+            skipLine();
+            quoted_sequence = false;
+            continue;
+        }
+        return true;
+    }
+}
+
+// Consume los separadores que siguen a un tramo de bases. Retorna true si la secuencia
+// del registro terminó (nueva cabecera, línea '+', fin de la fila o del archivo).
+bool SequenceStream::atSequenceEnd() {
+    while (true) {
+        int c = peekByte();
+        if (c == -1) {
+            return true;
+        }
+        if (format == SequenceFormat::CSV) {
+            if (c == '\r') {
+                getByte();
+                continue;
+            }
+            if (c == '\n') {
+                getByte();
+                return true;
+            }
+            if (c == ',' || (quoted_sequence && c == '"')) {
+                skipLine(); // columnas extra
+                return true;
+            }
+            return false;
+        }
+
+        if (c == '\n' || c == '\r') {
+            getByte();
+            continue;
+        }
+        if (line_start && format == SequenceFormat::FASTA && c == '>') {
+            return true;
+        }
+        if (line_start && format == SequenceFormat::FASTQ && c == '+') {
+            skipQuality(offset + bases.size());
+            return true;
+        }
+        return false;
+    }
+}
+
+// FASTQ: omite la línea '+' y tantos caracteres de calidad como bases tiene la secuencia.
+void SequenceStream::skipQuality(uint64_t length) {
+    skipLine();
+    uint64_t remaining = length;
+    while (remaining > 0 && peekByte() != -1) {
+        uint64_t line_length = skipLine();
+        remaining -= std::min(line_length, remaining);
+    }
+}
+
+// Agrega bases hasta que 'bases' tenga 'target' elementos o termine el registro.
+// Retorna true si el registro terminó.
+bool SequenceStream::fillSequence(size_t target) {
+    const auto& stops = format != SequenceFormat::CSV ? STOPS.line
+                      : quoted_sequence ? STOPS.quoted_field : STOPS.field;
+    while (true) {
+        if (atSequenceEnd()) {
+            return true;
+        }
+        if (bases.size() >= target) {
+            return false;
+        }
+
+        // Tramo de bases hasta el siguiente separador, el final del bloque o el fragmento lleno.
+        const char* begin = block.data() + block_pos;
+        const char* end = begin + std::min(block_length - block_pos, target - bases.size());
+        const char* stop = begin;
+        while (stop < end && !stops[static_cast<unsigned char>(*stop)]) {
+            ++stop;
+        }
+        std::string_view span(begin, stop - begin);
+        bases.append(span);
+        record_valid = record_valid && isValidSequence(span);
+        block_pos += span.size();
+        line_start = false;
+    }
+}
+
+void SequenceStream::finish() {
+    if (file == nullptr) {
+        return;
+    }
+    std::fclose(file);
+    file = nullptr;
+
+    if (record_count == 0) {
+        std::cerr << "ADVERTENCIA: No se encontraron registros válidos en el archivo de secuencias." << std::endl;
+    }
+    if (invalid_sequences > 0) {
+        std::cerr << "ADVERTENCIA: " << invalid_sequences
+                  << " secuencia(s) contienen caracteres fuera del alfabeto (A, C, G, T, N)." << std::endl;
+    }
+}
+
+bool SequenceStream::next(SequenceChunk& chunk) {
+    if (!in_record) {
+        if (!beginRecord()) {
+            finish();
+            return false;
+        }
+        in_record = true;
+        record_valid = true;
+        offset = 0;
+        bases.clear();
+        chunk.first = true;
+    } else {
+        // Se conservan las últimas 'overlap' bases al inicio del nuevo fragmento.
+        const size_t keep = std::min(overlap, bases.size());
+        offset += bases.size() - keep;
+        bases.erase(0, bases.size() - keep);
+        chunk.first = false;
+    }
+
+    chunk.overlap = bases.size();
+    chunk.last = fillSequence(bases.size() + chunk_bases);
+    chunk.name = name;
+    chunk.bases = bases;
+    chunk.offset = offset;
+
+    if (chunk.last) {
+        in_record = false;
+        ++record_count;
+        if (!record_valid) {
+            ++invalid_sequences;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef SEQUENCE_STREAM_HPP
+#define SEQUENCE_STREAM_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+// Formatos de entrada que se pueden leer por fragmentos.
+enum class SequenceFormat { CSV, FASTA, FASTQ };
+
+// Bases nuevas por fragmento si no se indica otra cantidad (16 Mi bases).
+const size_t DEFAULT_STREAM_CHUNK = size_t(1) << 24;
+
+// Tamaño de cada lectura del archivo.
+const size_t STREAM_READ_BLOCK = size_t(1) << 20;
+
+// Fragmento de la secuencia de un registro. 'bases' empieza con las últimas 'overlap'
+// bases del fragmento anterior del mismo registro (0 en el primero), de modo que una
+// coincidencia que cruza el límite entre fragmentos se puede leer completa.
+// Las vistas son válidas hasta la siguiente llamada a next().
+struct SequenceChunk {
+    std::string_view name;
+    std::string_view bases;
+    uint64_t offset;   // posición de bases[0] dentro de la secuencia del registro
+    size_t overlap;    // bases iniciales repetidas del fragmento anterior
+    bool first;        // primer fragmento del registro
+    bool last;         // último fragmento del registro (puede no traer bases nuevas)
+};
+
+// Deduce el formato por la extensión (.fa, .fasta, .fna, .fq, .fastq, .csv) o, si no
+// la reconoce, por el primer carácter del archivo ('>' FASTA, '@' FASTQ, otro CSV).
+SequenceFormat detectSequenceFormat(const std::string& path);
+
+// Lector por fragmentos de FASTA, FASTQ y CSV (Nombre,Cadena_ADN). La memoria usada
+// depende del tamaño de fragmento y no del tamaño del archivo, por lo que admite
+// secuencias de varios GB (cromosomas completos) sin cargarlas enteras.
+// - FASTA: el nombre es la primera palabra de la línea '>'; las líneas de secuencia se unen.
+// - FASTQ: el nombre es la primera palabra de la línea '@'; la calidad se descarta
+//   (admite secuencia y calidad repartidas en varias líneas).
+// - CSV: mismas reglas que loadMappedCSV (cabecera omitida, nombres entre comillas,
+//   secuencias entre comillas, columnas extra ignoradas, CRLF).
+class SequenceStream {
+public:
+    // overlap: bases del final de cada fragmento que se repiten al inicio del siguiente.
+    // chunk_bases (0 = DEFAULT_STREAM_CHUNK) nunca es menor que overlap.
+    SequenceStream(size_t chunk_bases, size_t overlap);
+    ~SequenceStream();
+    SequenceStream(const SequenceStream&) = delete;
+    SequenceStream& operator=(const SequenceStream&) = delete;
+
+    // Abre el archivo. Retorna false si no se pudo abrir.
+    bool open(const std::string& path, SequenceFormat format);
+
+    // Lee el siguiente fragmento. Retorna false al llegar al final del archivo.
+    bool next(SequenceChunk& chunk);
+
+    // Indica si la lectura se interrumpió por un error de E/S.
+    bool failed() const { return read_error; }
+
+    size_t recordCount() const { return record_count; }
+    // Registros con caracteres fuera del alfabeto (A, C, G, T, N).
+    size_t invalidSequences() const { return invalid_sequences; }
+
+private:
+    std::FILE* file = nullptr;
+    SequenceFormat format = SequenceFormat::CSV;
+    size_t chunk_bases;
+    size_t overlap;
+
+    std::vector<char> block;
+    size_t block_pos = 0;
+    size_t block_length = 0;
+    bool line_start = true;
+
+    std::string name;
+    std::string bases;
+    uint64_t offset = 0;
+    bool in_record = false;
+    bool record_valid = true;
+    bool quoted_sequence = false; // CSV: la secuencia empezó con comillas
+    size_t record_count = 0;
+    size_t invalid_sequences = 0;
+    bool read_error = false;
+
+    bool refill();
+    int peekByte();
+    int getByte();
+    uint64_t skipLine();
+    void readHeaderName();
+    void finish();
+    bool beginRecord();
+    bool atSequenceEnd();
+    void skipQuality(uint64_t length);
+    bool fillSequence(size_t target);
+};
+
+#endif
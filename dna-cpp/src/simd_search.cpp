@@ -0,0 +1,384 @@
+#include "simd_search.hpp"
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DNA_SIMD_X86 1
+#include <immintrin.h>
+// Cada kernel se compila para su conjunto de instrucciones aunque el resto del programa
+// no use -mavx2 ni -mavx512bw; solo se llama si la CPU lo admite.
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// --- Selección del conjunto de instrucciones ---
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+static SimdLevel detectSimdLevel() {
+    SimdLevel level = SimdLevel::SCALAR;
+#ifdef DNA_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        level = SimdLevel::SSE2;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        level = SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        level = SimdLevel::AVX512;
+    }
+#endif
+    const char* requested = std::getenv("DNA_SIMD");
+    if (requested != nullptr) {
+        for (SimdLevel candidate : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+            if (std::strcmp(requested, simdLevelName(candidate)) == 0 && candidate < level) {
+                level = candidate;
+            }
+        }
+    }
+    return level;
+}
+
+SimdLevel activeSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+// --- Verificación de candidatos ---
+
+static inline uint64_t loadWord(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+template <size_t... I>
+static inline bool equalWords(const char* a, const char* b, std::index_sequence<I...>) {
+    return ((loadWord(a + I * 8) == loadWord(b + I * 8)) & ... & true);
+}
+
+template <size_t... I>
+static inline bool equalBytes(const char* a, const char* b, std::index_sequence<I...>) {
+    return ((a[I] == b[I]) & ... & true);
+}
+
+// Longitud conocida al compilar: la comparación queda desenrollada (palabras de 8 bytes y
+// el resto byte a byte), sin bucle ni llamada a memcmp.
+template <size_t M>
+struct FixedCompare {
+    static bool equal(const char* window, const char* pattern, size_t) {
+        return equalWords(window, pattern, std::make_index_sequence<M / 8>()) &
+               equalBytes(window + M / 8 * 8, pattern + M / 8 * 8, std::make_index_sequence<M % 8>());
+    }
+};
+
+struct RuntimeCompare {
+    static bool equal(const char* window, const char* pattern, size_t m) {
+        return std::memcmp(window, pattern, m) == 0;
+    }
+};
+
+// --- Filtro del primer y el último carácter ---
+// Cada kernel compara un bloque de ventanas consecutivas a partir de i y deja i en la
+// primera ventana que no revisó; el resto lo termina scanScalar.
+
+template <class Compare>
+static void scanScalar(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches,
+                       size_t i) {
+    const size_t m = pattern.length();
+    const char first = pattern[0];
+    const char last = pattern[m - 1];
+    for (; i + m <= text.length(); ++i) {
+        if (text[i] == first && text[i + m - 1] == last && Compare::equal(text.data() + i, pattern.data(), m)) {
+            matches.push_back(i);
+        }
+    }
+}
+
+#ifdef DNA_SIMD_X86
+
+template <class Compare, class Mask>
+static inline void verifyCandidates(Mask mask, const char* text, size_t i, const std::string& pattern,
+                                    std::vector<int64_t>& matches) {
+    while (mask != 0) {
+        const size_t candidate = i + __builtin_ctzll(mask);
+        if (Compare::equal(text + candidate, pattern.data(), pattern.length())) {
+            matches.push_back(candidate);
+        }
+        mask &= mask - 1;
+    }
+}
+
+template <class Compare>
+SIMD_TARGET("sse2")
+static void scanSSE2(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches, size_t& i) {
+    const size_t m = pattern.length();
+    const char* data = text.data();
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last = _mm_set1_epi8(pattern[m - 1]);
+    for (; i + m - 1 + 16 <= text.length(); i += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + m - 1));
+        const __m128i hits = _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last));
+        verifyCandidates<Compare>(static_cast<uint32_t>(_mm_movemask_epi8(hits)), data, i, pattern, matches);
+    }
+}
+
+template <class Compare>
+SIMD_TARGET("avx2")
+static void scanAVX2(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches, size_t& i) {
+    const size_t m = pattern.length();
+    const char* data = text.data();
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last = _mm256_set1_epi8(pattern[m - 1]);
+    for (; i + m - 1 + 32 <= text.length(); i += 32) {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + m - 1));
+        const __m256i hits = _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                                              _mm256_cmpeq_epi8(block_last, last));
+        verifyCandidates<Compare>(static_cast<uint32_t>(_mm256_movemask_epi8(hits)), data, i, pattern, matches);
+    }
+}
+
+template <class Compare>
+SIMD_TARGET("avx512f,avx512bw")
+static void scanAVX512(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches, size_t& i) {
+    const size_t m = pattern.length();
+    const char* data = text.data();
+    const __m512i first = _mm512_set1_epi8(pattern[0]);
+    const __m512i last = _mm512_set1_epi8(pattern[m - 1]);
+    for (; i + m - 1 + 64 <= text.length(); i += 64) {
+        const __m512i block_first = _mm512_loadu_si512(data + i);
+        const __m512i block_last = _mm512_loadu_si512(data + i + m - 1);
+        const __mmask64 hits = _mm512_cmpeq_epi8_mask(block_first, first) & _mm512_cmpeq_epi8_mask(block_last, last);
+        verifyCandidates<Compare>(static_cast<uint64_t>(hits), data, i, pattern, matches);
+    }
+}
+
+#endif
+
+template <class Compare>
+static void scan(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches) {
+    size_t i = 0;
+#ifdef DNA_SIMD_X86
+    switch (activeSimdLevel()) {
+        case SimdLevel::AVX512: scanAVX512<Compare>(text, pattern, matches, i); break;
+        case SimdLevel::AVX2: scanAVX2<Compare>(text, pattern, matches, i); break;
+        case SimdLevel::SSE2: scanSSE2<Compare>(text, pattern, matches, i); break;
+        default: break;
+    }
+#endif
+    scanScalar<Compare>(text, pattern, matches, i);
+}
+
+using ScanFunction = void (*)(std::string_view, const std::string&, std::vector<int64_t>&);
+
+template <size_t... I>
+static constexpr std::array<ScanFunction, sizeof...(I)> fixedScans(std::index_sequence<I...>) {
+    return {{&scan<FixedCompare<MIN_FIXED_PATTERN + I>>...}};
+}
+
+// FIXED_SCANS[m - MIN_FIXED_PATTERN]: búsqueda especializada para patrones de m bases.
+static constexpr std::array<ScanFunction, MAX_FIXED_PATTERN - MIN_FIXED_PATTERN + 1> FIXED_SCANS =
+    fixedScans(std::make_index_sequence<MAX_FIXED_PATTERN - MIN_FIXED_PATTERN + 1>());
+
+std::vector<int64_t> SimdSearch(std::string_view text, const std::string& pattern) {
+    std::vector<int64_t> matches;
+    SimdSearch(text, pattern, matches);
+    return matches;
+}
+
+void SimdSearch(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches) {
+    const size_t m = pattern.length();
+    if (m == 0 || text.empty() || m > text.length()) {
+        return;
+    }
+
+    if (m >= MIN_FIXED_PATTERN && m <= MAX_FIXED_PATTERN) {
+        FIXED_SCANS[m - MIN_FIXED_PATTERN](text, pattern, matches);
+    } else {
+        scan<RuntimeCompare>(text, pattern, matches);
+    }
+}
+
+// --- Codificación y validación de bases ---
+
+const unsigned char BASE_N = 4;     // N o n: válida, pero ambigua
+const unsigned char BASE_OTHER = 5; // fuera del alfabeto
+
+// Clase de cada carácter para las bases que no completan un bloque de 64.
+struct BaseClassTable {
+    std::array<unsigned char, 256> code;
+
+    BaseClassTable() {
+        code.fill(BASE_OTHER);
+        code['A'] = 0; code['a'] = 0;
+        code['C'] = 1; code['c'] = 1;
+        code['G'] = 2; code['g'] = 2;
+        code['T'] = 3; code['t'] = 3;
+        code['N'] = BASE_N; code['n'] = BASE_N;
+    }
+};
+
+static const BaseClassTable BASE_CLASS;
+
+// Clasificación de 64 caracteres, un bit por carácter. En ASCII el código de 2 bits de una
+// base sale de sus bits 1 y 2 (A=0x41, C=0x43, G=0x47, T=0x54, igual en minúsculas):
+// código = (bit2 << 1) | (bit1 ^ bit2).
+struct BaseMasks {
+    uint64_t acgt = 0; // A, C, G o T
+    uint64_t n = 0;    // N
+    uint64_t bit1 = 0;
+    uint64_t bit2 = 0;
+};
+
+// Intercala ceros entre los 32 bits: el bit k pasa a la posición 2k.
+static inline uint64_t spreadBits(uint32_t value) {
+    uint64_t x = value;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+static BaseMasks classifyScalar(const char* p) {
+    BaseMasks masks;
+    for (unsigned k = 0; k < 64; ++k) {
+        const unsigned char c = static_cast<unsigned char>(p[k]);
+        const unsigned char code = BASE_CLASS.code[c];
+        masks.acgt |= uint64_t(code < BASE_N) << k;
+        masks.n |= uint64_t(code == BASE_N) << k;
+        masks.bit1 |= uint64_t((c >> 1) & 1) << k;
+        masks.bit2 |= uint64_t((c >> 2) & 1) << k;
+    }
+    return masks;
+}
+
+#ifdef DNA_SIMD_X86
+
+SIMD_TARGET("sse2")
+static BaseMasks classifySSE2(const char* p) {
+    BaseMasks masks;
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    for (unsigned k = 0; k < 4; ++k) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+        const __m128i lower = _mm_or_si128(v, case_bit);
+        const __m128i acgt = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('a')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('c'))),
+            _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('g')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('t'))));
+        const unsigned shift = 16 * k;
+        masks.acgt |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(acgt))) << shift;
+        masks.n |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lower, _mm_set1_epi8('n')))))
+                   << shift;
+        // El desplazamiento de 16 bits lleva el bit 1 (o 2) de cada byte a su bit 7.
+        masks.bit1 |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(v, 6)))) << shift;
+        masks.bit2 |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_slli_epi16(v, 5)))) << shift;
+    }
+    return masks;
+}
+
+SIMD_TARGET("avx2")
+static BaseMasks classifyAVX2(const char* p) {
+    BaseMasks masks;
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    for (unsigned k = 0; k < 2; ++k) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+        const __m256i lower = _mm256_or_si256(v, case_bit);
+        const __m256i acgt = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('a')),
+                            _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('c'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('g')),
+                            _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('t'))));
+        const unsigned shift = 32 * k;
+        masks.acgt |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(acgt))) << shift;
+        masks.n |= uint64_t(static_cast<uint32_t>(
+                       _mm256_movemask_epi8(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('n'))))) << shift;
+        masks.bit1 |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(v, 6)))) << shift;
+        masks.bit2 |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(v, 5)))) << shift;
+    }
+    return masks;
+}
+
+SIMD_TARGET("avx512f,avx512bw")
+static BaseMasks classifyAVX512(const char* p) {
+    BaseMasks masks;
+    const __m512i v = _mm512_loadu_si512(p);
+    const __m512i lower = _mm512_or_si512(v, _mm512_set1_epi8(0x20));
+    masks.acgt = _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('a')) |
+                 _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('c')) |
+                 _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('g')) |
+                 _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('t'));
+    masks.n = _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('n'));
+    masks.bit1 = _mm512_test_epi8_mask(v, _mm512_set1_epi8(0x02));
+    masks.bit2 = _mm512_test_epi8_mask(v, _mm512_set1_epi8(0x04));
+    return masks;
+}
+
+#endif
+
+using ClassifyFunction = BaseMasks (*)(const char*);
+
+static ClassifyFunction selectClassify() {
+#ifdef DNA_SIMD_X86
+    switch (activeSimdLevel()) {
+        case SimdLevel::AVX512: return classifyAVX512;
+        case SimdLevel::AVX2: return classifyAVX2;
+        case SimdLevel::SSE2: return classifySSE2;
+        default: break;
+    }
+#endif
+    return classifyScalar;
+}
+
+bool simdValidBases(std::string_view sequence) {
+    const ClassifyFunction classify = selectClassify();
+    const size_t blocks = sequence.length() / 64;
+    for (size_t b = 0; b < blocks; ++b) {
+        const BaseMasks masks = classify(sequence.data() + b * 64);
+        if ((masks.acgt | masks.n) != ~uint64_t(0)) {
+            return false;
+        }
+    }
+    unsigned char valid = 1;
+    for (size_t i = blocks * 64; i < sequence.length(); ++i) {
+        valid &= BASE_CLASS.code[static_cast<unsigned char>(sequence[i])] <= BASE_N;
+    }
+    return valid != 0;
+}
+
+bool simdPackBases(std::string_view sequence, uint64_t* bases, uint64_t* ambiguous) {
+    const ClassifyFunction classify = selectClassify();
+    const size_t blocks = sequence.length() / 64;
+    uint64_t any_ambiguous = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        const BaseMasks masks = classify(sequence.data() + b * 64);
+        const uint64_t high = masks.bit2 & masks.acgt;
+        const uint64_t low = (masks.bit1 ^ masks.bit2) & masks.acgt;
+        bases[2 * b] = spreadBits(static_cast<uint32_t>(low)) | (spreadBits(static_cast<uint32_t>(high)) << 1);
+        bases[2 * b + 1] = spreadBits(static_cast<uint32_t>(low >> 32)) |
+                           (spreadBits(static_cast<uint32_t>(high >> 32)) << 1);
+        ambiguous[b] = ~masks.acgt;
+        any_ambiguous |= ambiguous[b];
+    }
+    for (size_t i = blocks * 64; i < sequence.length(); ++i) {
+        const uint64_t code = BASE_CLASS.code[static_cast<unsigned char>(sequence[i])];
+        if (code >= BASE_N) {
+            ambiguous[i >> 6] |= uint64_t(1) << (i & 63);
+            any_ambiguous = 1;
+            continue;
+        }
+        bases[i >> 5] |= code << ((i & 31) * 2);
+    }
+    return any_ambiguous != 0;
+}
@@ -0,0 +1,43 @@
+#ifndef SIMD_SEARCH_HPP
+#define SIMD_SEARCH_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Conjunto de instrucciones vectoriales usado por los kernels. Se elige al ejecutar según
+// la CPU, por lo que el mismo ejecutable funciona en cualquier x86-64 (y en otras
+// arquitecturas usa siempre la versión escalar).
+enum class SimdLevel { SCALAR, SSE2, AVX2, AVX512 };
+
+// Mejor nivel disponible en esta CPU. La variable de entorno DNA_SIMD (scalar, sse2,
+// avx2 o avx512) permite bajar el nivel, p. ej. para comparar los kernels entre sí.
+SimdLevel activeSimdLevel();
+
+const char* simdLevelName(SimdLevel level);
+
+// Longitudes de patrón con comparación especializada en tiempo de compilación: la
+// verificación de cada candidato se desenrolla por completo.
+const size_t MIN_FIXED_PATTERN = 4;
+const size_t MAX_FIXED_PATTERN = 32;
+
+// Búsqueda exacta con filtro vectorial del primer y el último carácter del patrón: se
+// comparan 16, 32 o 64 ventanas por instrucción y solo las que coinciden en ambos extremos
+// se verifican completas. Devuelve las mismas posiciones que KMPSearch (con solapamientos).
+std::vector<int64_t> SimdSearch(std::string_view text, const std::string& pattern);
+
+// Igual que SimdSearch, pero agrega las posiciones al final de 'matches'.
+void SimdSearch(std::string_view text, const std::string& pattern, std::vector<int64_t>& matches);
+
+// Indica si la secuencia solo contiene A, C, G, T o N (mayúsculas o minúsculas).
+bool simdValidBases(std::string_view sequence);
+
+// Codifica la secuencia a 2 bits por base (A=0, C=1, G=2, T=3, 32 bases por palabra) en
+// 'bases', y marca en 'ambiguous' (1 bit por base) las que no son A, C, G ni T, que quedan
+// codificadas como A. Ambos arreglos deben venir en cero y tener (n + 31) / 32 y
+// (n + 63) / 64 palabras. Retorna true si hubo alguna base ambigua.
+bool simdPackBases(std::string_view sequence, uint64_t* bases, uint64_t* ambiguous);
+
+#endif
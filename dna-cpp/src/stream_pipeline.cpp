@@ -0,0 +1,229 @@
+#include "stream_pipeline.hpp"
+#include "bounded_queue.hpp"
+#include "parallel_search.hpp"
+#include "sequence_stream.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// Lote de fragmentos que pasa de una etapa a otra. Los fragmentos se reutilizan de un lote al
+// siguiente (conservan la memoria de sus textos y tablas); solo los primeros 'used' son válidos.
+struct PipelineBatch {
+    size_t sequence = 0; // orden de lectura
+    std::vector<PipelineChunk> chunks;
+    size_t used = 0;
+};
+
+// Espera hasta tomar un elemento de la cola y devuelve el tiempo de espera.
+template <typename T>
+static long long waitPop(BoundedQueue<T>& queue, T& value) {
+    if (queue.tryPop(value)) {
+        return 0;
+    }
+    PhaseTimer stall_timer;
+    Backoff backoff;
+    while (!queue.tryPop(value)) {
+        backoff.pause();
+    }
+    return stall_timer.elapsedNs();
+}
+
+// Las colas tienen lugar para todos los lotes, así que agregar nunca espera más que lo que
+// tarda otro hilo en terminar su operación.
+template <typename T>
+static void push(BoundedQueue<T>& queue, const T& value) {
+    Backoff backoff;
+    while (!queue.tryPush(value)) {
+        backoff.pause();
+    }
+}
+
+// Busca en un fragmento, como lo haría la lectura secuencial: las posiciones anteriores a
+// 'begin' se buscaron en el fragmento previo y las últimas 'after' bases se buscan en el
+// siguiente, salvo al final del registro.
+static void searchChunk(const SearchEngine& engine, PipelineChunk& chunk) {
+    const size_t after = engine.contextAfter();
+    const size_t begin = chunk.first ? 0 : chunk.overlap - after;
+    const size_t end = chunk.last ? chunk.bases.size() : chunk.bases.size() - after;
+    if (engine.usesPackedInput()) {
+        searchSequence(engine, packSequence(chunk.bases), begin, end, 1, chunk.matches);
+    } else {
+        searchSequence(engine, chunk.bases, begin, end, 1, chunk.matches);
+    }
+    if (chunk.offset != 0) {
+        for (int64_t& position : chunk.matches.positions) {
+            position += chunk.offset;
+        }
+    }
+}
+
+bool runStreamPipeline(const std::string& path, const SearchEngine& engine, size_t chunk_bases, unsigned threads,
+                       size_t depth, const PipelineEmitter& emit, SearchMetrics& metrics) {
+    SequenceStream stream(chunk_bases, engine.contextBefore() + engine.contextAfter());
+    if (!stream.open(path, detectSequenceFormat(path))) {
+        return false;
+    }
+    const unsigned workers = std::max(1u, threads);
+    const size_t batch_count = depth > 0 ? depth : workers * PIPELINE_BATCHES_PER_THREAD + 2;
+
+    // Todos los lotes empiezan libres. El lector los llena y los pasa a los buscadores, que los
+    // pasan al escritor; el escritor los devuelve libres una vez entregados. Una marca nula por
+    // buscador indica el final.
+    std::vector<PipelineBatch> batches(batch_count);
+    BoundedQueue<PipelineBatch*> free_batches(batch_count);
+    BoundedQueue<PipelineBatch*> read_batches(batch_count + workers);
+    BoundedQueue<PipelineBatch*> searched_batches(batch_count);
+    for (PipelineBatch& batch : batches) {
+        free_batches.tryPush(&batch);
+    }
+    std::atomic<size_t> batch_total{SIZE_MAX};       // lotes leídos, cuando el lector termina
+    std::atomic<size_t> satisfied_record{SIZE_MAX};  // registro que ya tiene lo que pide la consulta
+    std::atomic<long long> search_ns{0};
+    std::atomic<long long> search_stall_ns{0};
+    long long read_ns = 0;
+    long long read_stall_ns = 0;
+    uint64_t search_queue_peak = 0;
+
+    std::thread reader([&]() {
+        size_t sequence = 0;
+        size_t record = 0;
+        PipelineBatch* batch = nullptr;
+        size_t batch_bases = 0;
+        auto submit = [&]() {
+            batch->sequence = sequence++;
+            push(read_batches, batch);
+            search_queue_peak = std::max<uint64_t>(search_queue_peak, read_batches.size());
+            batch = nullptr;
+        };
+
+        SequenceChunk chunk;
+        while (true) {
+            PhaseTimer read_timer;
+            if (!stream.next(chunk)) {
+                read_ns += read_timer.elapsedNs();
+                break;
+            }
+            read_ns += read_timer.elapsedNs();
+            if (batch == nullptr) {
+                // Contrapresión: sin lotes libres, el lector espera a las etapas siguientes.
+                read_stall_ns += waitPop(free_batches, batch);
+                batch->used = 0;
+                batch_bases = 0;
+            }
+            PhaseTimer copy_timer;
+            if (batch->used == batch->chunks.size()) {
+                batch->chunks.emplace_back();
+            }
+            PipelineChunk& copy = batch->chunks[batch->used++];
+            copy.name.assign(chunk.name.data(), chunk.name.size());
+            copy.bases.assign(chunk.bases.data(), chunk.bases.size());
+            copy.offset = chunk.offset;
+            copy.overlap = chunk.overlap;
+            copy.first = chunk.first;
+            copy.last = chunk.last;
+            if (chunk.first) {
+                ++record;
+            }
+            copy.record = record - 1;
+            batch_bases += chunk.bases.size();
+            read_ns += copy_timer.elapsedNs();
+            if (batch_bases >= PIPELINE_BATCH_BASES) {
+                submit();
+            }
+        }
+        if (batch != nullptr) {
+            submit();
+        }
+        batch_total.store(sequence, std::memory_order_release);
+        for (unsigned w = 0; w < workers; ++w) {
+            push(read_batches, static_cast<PipelineBatch*>(nullptr));
+        }
+    });
+
+    auto worker = [&]() {
+        long long busy_ns = 0;
+        long long stall_ns = 0;
+        while (true) {
+            PipelineBatch* batch = nullptr;
+            stall_ns += waitPop(read_batches, batch);
+            if (batch == nullptr) {
+                break;
+            }
+            PhaseTimer search_timer;
+            for (size_t i = 0; i < batch->used; ++i) {
+                PipelineChunk& chunk = batch->chunks[i];
+                chunk.matches.clear();
+                chunk.searched = chunk.record != satisfied_record.load(std::memory_order_acquire);
+                if (chunk.searched) {
+                    searchChunk(engine, chunk);
+                }
+            }
+            busy_ns += search_timer.elapsedNs();
+            push(searched_batches, batch);
+        }
+        search_ns += busy_ns;
+        search_stall_ns += stall_ns;
+    };
+    std::vector<std::thread> searchers;
+    for (unsigned w = 0; w < workers; ++w) {
+        searchers.emplace_back(worker);
+    }
+
+    // Escritor: los lotes llegan en cualquier orden y se entregan en el de lectura. Como el
+    // lector solo toma un lote que el escritor ya liberó, los lotes en curso son siempre
+    // menos que batch_count y cada uno tiene su lugar fijo en 'ready'.
+    std::vector<PipelineBatch*> ready(batch_count, nullptr);
+    size_t next = 0;
+    size_t waiting = 0;
+    long long write_stall_ns = 0;
+    uint64_t write_queue_peak = 0;
+    while (next != batch_total.load(std::memory_order_acquire)) {
+        PipelineBatch* batch = nullptr;
+        if (!searched_batches.tryPop(batch)) {
+            PhaseTimer stall_timer;
+            Backoff backoff;
+            bool popped = false;
+            while (!(popped = searched_batches.tryPop(batch)) && next != batch_total.load(std::memory_order_acquire)) {
+                backoff.pause();
+            }
+            write_stall_ns += stall_timer.elapsedNs();
+            if (!popped) {
+                break;
+            }
+        }
+        ready[batch->sequence % batch_count] = batch;
+        ++waiting;
+        write_queue_peak = std::max<uint64_t>(write_queue_peak, waiting + searched_batches.size());
+        while (ready[next % batch_count] != nullptr) {
+            PipelineBatch* in_order = ready[next % batch_count];
+            ready[next % batch_count] = nullptr;
+            --waiting;
+            for (size_t i = 0; i < in_order->used; ++i) {
+                PipelineChunk& chunk = in_order->chunks[i];
+                if (emit(chunk) && !chunk.last) {
+                    satisfied_record.store(chunk.record, std::memory_order_release);
+                }
+            }
+            ++next;
+            push(free_batches, in_order);
+        }
+    }
+
+    reader.join();
+    for (auto& searcher : searchers) {
+        searcher.join();
+    }
+
+    metrics.load_ns += read_ns;
+    metrics.search_ns += search_ns.load();
+    metrics.pipeline_batches += next;
+    metrics.read_stall_ns += read_stall_ns;
+    metrics.search_stall_ns += search_stall_ns.load();
+    metrics.write_stall_ns += write_stall_ns;
+    metrics.search_queue_peak = std::max(metrics.search_queue_peak, search_queue_peak);
+    metrics.write_queue_peak = std::max(metrics.write_queue_peak, write_queue_peak);
+    metrics.counters.suspects_processed = stream.recordCount();
+    return !stream.failed();
+}
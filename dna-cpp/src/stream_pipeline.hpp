@@ -0,0 +1,51 @@
+#ifndef STREAM_PIPELINE_HPP
+#define STREAM_PIPELINE_HPP
+
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include "metrics.hpp"
+#include "search_engine.hpp"
+
+// Bases que el lector reúne en un lote antes de entregarlo: los registros cortos viajan
+// juntos y un fragmento largo ocupa un lote solo.
+const size_t PIPELINE_BATCH_BASES = size_t(1) << 20;
+
+// Lotes en curso por hilo de búsqueda si no se indica otra profundidad, más dos: el que llena
+// el lector y el que vacía el escritor.
+const size_t PIPELINE_BATCHES_PER_THREAD = 2;
+
+// Fragmento de un registro (ver SequenceChunk) con sus coincidencias, tal como lo recibe el
+// escritor.
+struct PipelineChunk {
+    std::string name;
+    std::string bases;
+    uint64_t offset = 0;
+    size_t overlap = 0;
+    bool first = false;
+    bool last = false;
+    size_t record = 0;     // número del registro en el archivo
+    bool searched = false; // false si se omitió porque el registro ya tenía lo que pide la consulta
+    MatchTable matches;    // una fila por patrón, con posiciones dentro de la secuencia del registro
+};
+
+// Recibe cada fragmento en el orden del archivo. Retorna true si el registro ya tiene todas
+// las coincidencias que pide la consulta: sus fragmentos restantes no hace falta buscarlos.
+using PipelineEmitter = std::function<bool(PipelineChunk& chunk)>;
+
+// Lectura por fragmentos en tres etapas que trabajan a la vez:
+// - un hilo lector parte el archivo con SequenceStream y llena lotes de fragmentos;
+// - 'threads' hilos buscan en los lotes (cada fragmento en un solo hilo);
+// - el hilo que llama entrega los fragmentos a 'emit' en el orden del archivo.
+// Las etapas se pasan los lotes por colas acotadas sin bloqueos (BoundedQueue). Hay 'depth'
+// lotes en total (0 = PIPELINE_BATCHES_PER_THREAD por hilo + 2) que se reciclan: si los
+// buscadores o el escritor se atrasan, el lector espera un lote libre, así que la memoria
+// depende de la profundidad y del tamaño de fragmento, no del archivo.
+// Suma a 'metrics' el tiempo de lectura (load_ns), el de búsqueda de todos los hilos
+// (search_ns) y las esperas y colas de cada etapa. Retorna false si no se pudo abrir o leer el archivo.
+bool runStreamPipeline(const std::string& path, const SearchEngine& engine, size_t chunk_bases, unsigned threads,
+                       size_t depth, const PipelineEmitter& emit, SearchMetrics& metrics);
+
+#endif